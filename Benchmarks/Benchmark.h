@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+// Small timing helpers shared by the benchmarks in this directory.
+// Each benchmark is a plain executable that prints its results; run them from
+// an optimized build (RelWithDebInfo or Release).
+namespace Benchmark
+{
+	using Clock = std::chrono::steady_clock;
+
+	inline double elapsedMs(Clock::time_point start, Clock::time_point end)
+	{
+		return std::chrono::duration<double, std::milli>(end - start).count();
+	}
+
+	// Runs the body several times and keeps the fastest, which filters out
+	// the noise of page faults and other processes on the first runs
+	template<typename Fn>
+	double bestOfMs(int runs, Fn&& body)
+	{
+		double best = 0.0;
+		for (int i = 0; i < runs; i++)
+		{
+			Clock::time_point start = Clock::now();
+			body();
+			double ms = elapsedMs(start, Clock::now());
+			if (i == 0 || ms < best)
+				best = ms;
+		}
+		return best;
+	}
+
+	// Folds a result into a volatile so the optimizer cannot drop the work that produced it
+	inline void keep(uint64_t value)
+	{
+		static volatile uint64_t sink = 0;
+		sink = sink + value;
+	}
+
+	inline void printRatio(const char* label, double slowMs, double fastMs)
+	{
+		std::printf("%-40s %8.2fx\n", label, fastMs > 0.0 ? slowMs / fastMs : 0.0);
+	}
+}
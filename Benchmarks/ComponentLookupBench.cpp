@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "Engine2000/GameObject.h"
+#include <vector>
+
+// GameObject::getComponent<T>() (type id + mask) against the dynamic_cast walk over
+// the component list it replaced. The lookups go to the last component added, the
+// worst case of the old walk, and to one the object does not have.
+
+namespace
+{
+	struct Health : Component { using Component::Component; int value = 100; };
+	struct Weapon : Component { using Component::Component; int value = 1; };
+	struct Shield : Component { using Component::Component; int value = 2; };
+	struct Score : Component { using Component::Component; int value = 3; };
+	struct Target : Component { using Component::Component; int value = 4; };
+	struct Missing : Component { using Component::Component; };
+
+	// The pre-type-id lookup, kept here only for comparison
+	template<typename T>
+	T* findByCast(const std::vector<Component*>& components)
+	{
+		for (Component* component : components)
+		{
+			if (T* castComponent = dynamic_cast<T*>(component))
+				return castComponent;
+		}
+		return nullptr;
+	}
+}
+
+int main()
+{
+	const int objectCount = 10000;
+	const int passes = 20;
+	const int runs = 5;
+
+	std::vector<GameObject*> objects;
+	std::vector<std::vector<Component*>> componentLists(objectCount);
+	objects.reserve(objectCount);
+	for (int i = 0; i < objectCount; i++)
+	{
+		GameObject* object = new GameObject();
+		std::vector<Component*>& list = componentLists[i];
+		list.push_back(object->getTransform());
+		list.push_back(object->addComponent<Health>());
+		list.push_back(object->addComponent<Weapon>());
+		list.push_back(object->addComponent<Shield>());
+		list.push_back(object->addComponent<Score>());
+		list.push_back(object->addComponent<Target>());
+		objects.push_back(object);
+	}
+
+	const double lookups = double(objectCount) * passes;
+
+	double typeIdMs = Benchmark::bestOfMs(runs, [&]() {
+		uint64_t sum = 0;
+		for (int pass = 0; pass < passes; pass++)
+			for (GameObject* object : objects)
+				sum += object->getComponent<Target>()->value;
+		Benchmark::keep(sum);
+	});
+	double castMs = Benchmark::bestOfMs(runs, [&]() {
+		uint64_t sum = 0;
+		for (int pass = 0; pass < passes; pass++)
+			for (const std::vector<Component*>& list : componentLists)
+				sum += findByCast<Target>(list)->value;
+		Benchmark::keep(sum);
+	});
+
+	double typeIdMissMs = Benchmark::bestOfMs(runs, [&]() {
+		uint64_t found = 0;
+		for (int pass = 0; pass < passes; pass++)
+			for (GameObject* object : objects)
+				found += object->getComponent<Missing>() != nullptr;
+		Benchmark::keep(found);
+	});
+	double castMissMs = Benchmark::bestOfMs(runs, [&]() {
+		uint64_t found = 0;
+		for (int pass = 0; pass < passes; pass++)
+			for (const std::vector<Component*>& list : componentLists)
+				found += findByCast<Missing>(list) != nullptr;
+		Benchmark::keep(found);
+	});
+
+	std::printf("%d objects x 6 components, %d passes\n", objectCount, passes);
+	std::printf("%-24s %10s %10s\n", "lookup", "type id", "cast walk");
+	std::printf("%-24s %8.2fns %8.2fns\n", "present (last added)", typeIdMs * 1e6 / lookups, castMs * 1e6 / lookups);
+	std::printf("%-24s %8.2fns %8.2fns\n", "absent", typeIdMissMs * 1e6 / lookups, castMissMs * 1e6 / lookups);
+	Benchmark::printRatio("speedup, present", castMs, typeIdMs);
+	Benchmark::printRatio("speedup, absent", castMissMs, typeIdMissMs);
+
+	for (GameObject* object : objects)
+		delete object;
+	return 0;
+}
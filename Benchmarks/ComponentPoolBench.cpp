@@ -0,0 +1,156 @@
+#include "Benchmark.h"
+#include "Engine2000/GameObject.h"
+#include "Engine2000/ComponentPools.h"
+#include "Engine2000/SpriteComponent.h"
+#include <random>
+#include <vector>
+
+// Per-frame component update with heap-allocated components (each GameObject
+// walks its own list) against ComponentPools (one linear pass per type), the
+// way Level::update runs either mode. Before timing, a share of the objects is
+// despawned and respawned to give the heap the fragmentation a level builds up.
+// The layout columns hold the access pattern fixed (sprites updated in object
+// order) so only where the components live differs: scattered heap blocks or
+// pool chunks.
+
+namespace
+{
+	const float DELTA_TIME = 1.0f / 60.0f;
+
+	GameObject* spawn(float x, float y)
+	{
+		GameObject* object = new GameObject();
+		object->getTransform()->setPosition(x, y);
+		object->addComponent<SpriteComponent>();
+		return object;
+	}
+
+	void populate(std::vector<GameObject*>& objects, int count, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float> position(0.0f, 640.0f);
+		for (int i = 0; i < count; i++)
+			objects.push_back(spawn(position(rng), position(rng)));
+
+		// Churn: respawn half the objects in random slots, as projectiles and enemies do
+		std::uniform_int_distribution<size_t> slot(0, objects.size() - 1);
+		for (int i = 0; i < count / 2; i++)
+		{
+			size_t index = slot(rng);
+			delete objects[index];
+			objects[index] = spawn(position(rng), position(rng));
+		}
+	}
+
+	void clear(std::vector<GameObject*>& objects)
+	{
+		for (GameObject* object : objects)
+			delete object;
+		objects.clear();
+	}
+
+	// Mirrors Level::update: every object, then the pools' system pass when enabled
+	void updateFrame(const std::vector<GameObject*>& objects)
+	{
+		for (GameObject* object : objects)
+			object->update(DELTA_TIME);
+		if (ComponentPools::Instance().isEnabled())
+			ComponentPools::Instance().update(DELTA_TIME);
+	}
+
+	// Same walk for both layouts: each object's sprite, in object order
+	std::vector<SpriteComponent*> collectSprites(const std::vector<GameObject*>& objects)
+	{
+		std::vector<SpriteComponent*> sprites;
+		sprites.reserve(objects.size());
+		for (GameObject* object : objects)
+			sprites.push_back(object->getComponent<SpriteComponent>());
+		return sprites;
+	}
+
+	void updateSprites(const std::vector<SpriteComponent*>& sprites)
+	{
+		for (SpriteComponent* sprite : sprites)
+			sprite->update(DELTA_TIME);
+	}
+
+	// Heap mode first: the pools are only used by objects created after they are enabled
+	struct Result
+	{
+		double heapNs;
+		double pooledNs;
+		double poolPassNs;	// The pools' system pass on its own, without the object walk
+		double heapLayoutNs;	// Sprites in object order, heap-allocated
+		double poolLayoutNs;	// Sprites in object order, pool-allocated
+	};
+
+	Result run(int count)
+	{
+		const int frames = 20;
+		const int runs = 5;
+		std::vector<GameObject*> objects;
+
+		std::mt19937 heapRng(1234);
+		ComponentPools::Instance().setEnabled(false);
+		populate(objects, count, heapRng);
+		double heapMs = Benchmark::bestOfMs(runs, [&]() {
+			for (int frame = 0; frame < frames; frame++)
+				updateFrame(objects);
+		});
+		std::vector<SpriteComponent*> sprites = collectSprites(objects);
+		double heapLayoutMs = Benchmark::bestOfMs(runs, [&]() {
+			for (int frame = 0; frame < frames; frame++)
+				updateSprites(sprites);
+		});
+		clear(objects);
+
+		std::mt19937 pooledRng(1234);
+		ComponentPools::Instance().setEnabled(true);
+		populate(objects, count, pooledRng);
+		double pooledMs = Benchmark::bestOfMs(runs, [&]() {
+			for (int frame = 0; frame < frames; frame++)
+				updateFrame(objects);
+		});
+		double poolPassMs = Benchmark::bestOfMs(runs, [&]() {
+			for (int frame = 0; frame < frames; frame++)
+				ComponentPools::Instance().update(DELTA_TIME);
+		});
+		sprites = collectSprites(objects);
+		double poolLayoutMs = Benchmark::bestOfMs(runs, [&]() {
+			for (int frame = 0; frame < frames; frame++)
+				updateSprites(sprites);
+		});
+		clear(objects);
+		ComponentPools::Instance().setEnabled(false);
+
+		const double perObject = 1e6 / (double(count) * frames);
+		return { heapMs * perObject, pooledMs * perObject, poolPassMs * perObject,
+			heapLayoutMs * perObject, poolLayoutMs * perObject };
+	}
+}
+
+int main()
+{
+	const int counts[] = { 1000, 10000, 50000, 200000 };
+	std::vector<Result> results;
+	for (int count : counts)
+		results.push_back(run(count));
+
+	std::printf("Transform + Sprite per object, ns per object per frame\n");
+	std::printf("%-10s %10s %10s %10s %10s\n", "objects", "heap", "pooled", "pool pass", "speedup");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Result& ns = results[i];
+		std::printf("%-10d %8.2fns %8.2fns %8.2fns %9.2fx\n",
+			counts[i], ns.heapNs, ns.pooledNs, ns.poolPassNs, ns.heapNs / ns.pooledNs);
+	}
+
+	std::printf("\nSame access pattern (sprites in object order), ns per sprite per frame\n");
+	std::printf("%-10s %10s %10s %10s\n", "objects", "heap", "pool", "speedup");
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		const Result& ns = results[i];
+		std::printf("%-10d %8.2fns %8.2fns %9.2fx\n",
+			counts[i], ns.heapLayoutNs, ns.poolLayoutNs, ns.heapLayoutNs / ns.poolLayoutNs);
+	}
+	return 0;
+}
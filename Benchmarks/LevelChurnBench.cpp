@@ -0,0 +1,142 @@
+#include "Benchmark.h"
+#include "Engine2000/GameObject.h"
+#include "Engine2000/Input.h"
+#include "Engine2000/Level.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Mass spawn/despawn: each frame a tenth of the live objects is removed at random
+// and as many are spawned, then the lists are processed. Level's slot-indexed
+// removal is compared with the std::find + erase it replaced, reimplemented below.
+// The objects carry only a transform, so no physics work is timed.
+
+namespace
+{
+	const int FRAMES = 10;
+	const int RUNS = 3;
+
+	// The find + erase bookkeeping Level used before, kept here only for comparison
+	class FindEraseLayers
+	{
+	private:
+		std::vector<GameObject*> m_layers[Level::TOTAL_LAYERS];
+		std::vector<GameObject*> m_pendingAdds;
+		std::vector<GameObject*> m_pendingRemoves;
+
+	public:
+		~FindEraseLayers()
+		{
+			processLists();
+			for (auto& layer : m_layers)
+				for (GameObject* obj : layer)
+					delete obj;
+		}
+
+		GameObject* spawn()
+		{
+			GameObject* obj = new GameObject();
+			m_pendingAdds.push_back(obj);
+			return obj;
+		}
+
+		void remove(GameObject* obj) { m_pendingRemoves.push_back(obj); }
+
+		void processLists()
+		{
+			for (GameObject* obj : m_pendingRemoves)
+			{
+				for (auto& layer : m_layers)
+				{
+					auto it = std::find(layer.begin(), layer.end(), obj);
+					if (it != layer.end())
+					{
+						layer.erase(it);
+						break;
+					}
+				}
+				delete obj;
+			}
+			m_pendingRemoves.clear();
+
+			for (GameObject* obj : m_pendingAdds)
+				m_layers[Level::GAME].push_back(obj);
+			m_pendingAdds.clear();
+		}
+	};
+
+	// Runs the churn against either bookkeeping; 'live' mirrors what the game would hold
+	template<typename SpawnFn, typename RemoveFn, typename ProcessFn>
+	void churn(std::vector<GameObject*>& live, std::mt19937& rng, SpawnFn spawn, RemoveFn remove, ProcessFn process)
+	{
+		const size_t count = live.size();
+		const size_t wave = std::max<size_t>(1, count / 10);
+		for (int frame = 0; frame < FRAMES; frame++)
+		{
+			for (size_t i = 0; i < wave; i++)
+			{
+				size_t index = std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng);
+				remove(live[index]);
+				live[index] = live.back();
+				live.pop_back();
+			}
+			for (size_t i = 0; i < wave; i++)
+				live.push_back(spawn());
+			process();
+		}
+	}
+
+	double timeLevel(int count)
+	{
+		Input input;
+		Level level(input, 640, 480);
+		std::vector<GameObject*> live;
+		for (int i = 0; i < count; i++)
+			live.push_back(level.createGameObject<GameObject>(Level::GAME));
+		level.processLists();
+
+		std::mt19937 rng(1234);
+		return Benchmark::bestOfMs(RUNS, [&]() {
+			churn(live, rng,
+				[&]() { return level.createGameObject<GameObject>(Level::GAME); },
+				[&](GameObject* obj) { level.removeGameObject(obj); },
+				[&]() { level.processLists(); });
+		});
+	}
+
+	double timeFindErase(int count)
+	{
+		FindEraseLayers layers;
+		std::vector<GameObject*> live;
+		for (int i = 0; i < count; i++)
+			live.push_back(layers.spawn());
+		layers.processLists();
+
+		std::mt19937 rng(1234);
+		return Benchmark::bestOfMs(RUNS, [&]() {
+			churn(live, rng,
+				[&]() { return layers.spawn(); },
+				[&](GameObject* obj) { layers.remove(obj); },
+				[&]() { layers.processLists(); });
+		});
+	}
+}
+
+int main()
+{
+	// Measured first and printed after, as each Level's PhysicsWorld::init logs
+	const int counts[] = { 1000, 10000, 50000 };
+	double levelMs[3];
+	double findEraseMs[3];
+	for (int i = 0; i < 3; i++)
+	{
+		levelMs[i] = timeLevel(counts[i]) / FRAMES;
+		findEraseMs[i] = timeFindErase(counts[i]) / FRAMES;
+	}
+
+	std::printf("10%% of objects despawned and respawned per frame, ms per frame\n");
+	std::printf("%-10s %10s %12s %10s\n", "objects", "Level", "find+erase", "speedup");
+	for (int i = 0; i < 3; i++)
+		std::printf("%-10d %8.3fms %10.3fms %9.2fx\n", counts[i], levelMs[i], findEraseMs[i], findEraseMs[i] / levelMs[i]);
+	return 0;
+}
@@ -0,0 +1,171 @@
+#include "Benchmark.h"
+#include "Engine2000/JobSystem.h"
+#include "Engine2000/PhysicsLayerManager.h"
+#include "Engine2000/PhysicsWorld.h"
+#include <random>
+#include <vector>
+
+// PhysicsWorld::update on the Box2D and arcade backends for a shooter-like scene:
+// 5k moving bodies, each with a solid box and a sensor box built the way
+// PhysicsComponent builds them. Half are enemies on kinematic bodies and half are
+// projectiles on dynamic ones. Every 30 steps all velocities flip, so the crowd stays
+// in the field. The time covers the step and the event gathering.
+
+namespace
+{
+	const int BODY_COUNT = 5000;
+	const float FIELD_SIZE = 2000.0f;
+	const float BOX_SIZE = 24.0f;
+	const int WARMUP_STEPS = 30;
+	const int MEASURED_STEPS = 180;
+	const float DELTA_TIME = 1.0f / 60.0f;
+
+	struct Spawn
+	{
+		float x, y, vx, vy;
+		bool isProjectile;
+	};
+
+	std::vector<Spawn> makeSpawns()
+	{
+		std::mt19937 rng(1234);
+		std::uniform_real_distribution<float> position(0.0f, FIELD_SIZE);
+		std::uniform_real_distribution<float> velocity(-100.0f, 100.0f);
+
+		std::vector<Spawn> spawns(BODY_COUNT);
+		for (int i = 0; i < BODY_COUNT; i++)
+			spawns[i] = { position(rng), position(rng), velocity(rng), velocity(rng), i % 2 == 1 };
+		return spawns;
+	}
+
+	b2Filter layerFilter(int layer)
+	{
+		const PhysicsLayerManager& layers = PhysicsLayerManager::getInstance();
+		b2Filter filter = b2DefaultFilter();
+		filter.categoryBits = layers.getCategoryBits(layer);
+		filter.maskBits = layers.getMaskBits(layer);
+		return filter;
+	}
+
+	b2Filter sensorFilter()
+	{
+		b2Filter filter = b2DefaultFilter();
+		filter.categoryBits = PhysicsLayerManager::SENSOR_CATEGORY;
+		filter.maskBits = PhysicsLayerManager::ALL_LAYERS;
+		return filter;
+	}
+
+	// Set up as PhysicsWorld::createComponentBody and createComponentShape do, without a component
+	b2BodyId createBox2DBody(PhysicsWorld& world, const Spawn& spawn, int layer)
+	{
+		b2BodyDef bodyDef = b2DefaultBodyDef();
+		bodyDef.type = spawn.isProjectile ? b2_dynamicBody : b2_kinematicBody;
+		bodyDef.position = { spawn.x, spawn.y };
+		bodyDef.gravityScale = 0.0f;
+		bodyDef.fixedRotation = true;
+		b2BodyId bodyId = b2CreateBody(world.getWorldId(), &bodyDef);
+
+		// Centred on the body, as PhysicsWorld::createBoxShape makes the arcade boxes
+		b2Polygon box = b2MakeBox(BOX_SIZE / 2.0f, BOX_SIZE / 2.0f);
+		for (int i = 0; i < 2; i++)
+		{
+			bool isSensor = i == 1;
+			b2ShapeDef shapeDef = b2DefaultShapeDef();
+			shapeDef.isSensor = isSensor;
+			shapeDef.enableSensorEvents = isSensor;
+			shapeDef.friction = 0.0f;
+			shapeDef.restitution = 0.0f;
+			shapeDef.filter = isSensor ? sensorFilter() : layerFilter(layer);
+			b2CreatePolygonShape(bodyId, &shapeDef, &box);
+		}
+		return bodyId;
+	}
+
+	// ArcadeWorld is internal to the engine, so this goes through PhysicsWorld
+	b2BodyId createArcadeBody(PhysicsWorld& world, const Spawn& spawn, int layer)
+	{
+		b2BodyId bodyId = world.createBody(Vector2D(spawn.x, spawn.y), spawn.isProjectile);
+
+		b2ShapeId solid = world.createBoxShape(bodyId, BOX_SIZE, BOX_SIZE);
+		world.setShapeFilter(solid, layerFilter(layer));
+
+		b2ShapeId sensor = world.createBoxShape(bodyId, BOX_SIZE, BOX_SIZE, 1.0f, true);
+		world.setShapeFilter(sensor, sensorFilter());
+		return bodyId;
+	}
+
+	struct Result
+	{
+		double stepMs;
+		double eventsPerStep;	// Begins and ends found, none of which reach a component here
+	};
+
+	Result run(PhysicsBackend backend, int threadCount, const std::vector<Spawn>& spawns)
+	{
+		const int enemyLayer = PhysicsLayerManager::getInstance().getLayerIndex("Enemy");
+		const int projectileLayer = PhysicsLayerManager::getInstance().getLayerIndex("Projectile");
+
+		PhysicsWorld world;
+		world.init(FIELD_SIZE, FIELD_SIZE, Vector2D(0.0f, 0.0f), threadCount, backend);
+
+		std::vector<b2BodyId> bodies;
+		bodies.reserve(spawns.size());
+		for (const Spawn& spawn : spawns)
+		{
+			int layer = spawn.isProjectile ? projectileLayer : enemyLayer;
+			b2BodyId bodyId = backend == PhysicsBackend::Arcade
+				? createArcadeBody(world, spawn, layer)
+				: createBox2DBody(world, spawn, layer);
+			world.setBodyVelocity(bodyId, Vector2D(spawn.vx, spawn.vy));
+			bodies.push_back(bodyId);
+		}
+
+		float direction = 1.0f;
+		double totalMs = 0.0;
+		double events = 0.0;
+		for (int step = 0; step < WARMUP_STEPS + MEASURED_STEPS; step++)
+		{
+			if (step > 0 && step % 30 == 0)
+			{
+				direction = -direction;
+				for (size_t i = 0; i < bodies.size(); i++)
+					world.setBodyVelocity(bodies[i], Vector2D(spawns[i].vx * direction, spawns[i].vy * direction));
+			}
+
+			Benchmark::Clock::time_point start = Benchmark::Clock::now();
+			world.update(DELTA_TIME);
+			Benchmark::Clock::time_point end = Benchmark::Clock::now();
+
+			if (step >= WARMUP_STEPS)
+			{
+				totalMs += Benchmark::elapsedMs(start, end);
+				events += world.getEventStats().skipped;
+			}
+		}
+		world.cleanup();
+		return { totalMs / MEASURED_STEPS, events / MEASURED_STEPS };
+	}
+}
+
+int main()
+{
+	JobSystem::Instance().init();
+	std::vector<Spawn> spawns = makeSpawns();
+
+	// Measured first and printed after, as PhysicsWorld::init logs
+	Result box2dSingle = run(PhysicsBackend::Box2D, 1, spawns);
+	Result box2dThreaded = run(PhysicsBackend::Box2D, 0, spawns);
+	Result arcade = run(PhysicsBackend::Arcade, 1, spawns);
+
+	std::printf("\n%d moving bodies with a solid and a sensor box, ms per step (average of %d)\n",
+		BODY_COUNT, MEASURED_STEPS);
+	std::printf("%-28s %10s %12s\n", "backend", "step", "events/step");
+	std::printf("%-28s %8.3fms %12.1f\n", "Box2D, 1 thread", box2dSingle.stepMs, box2dSingle.eventsPerStep);
+	std::printf("%-28s %8.3fms %12.1f\n", "Box2D, all threads", box2dThreaded.stepMs, box2dThreaded.eventsPerStep);
+	std::printf("%-28s %8.3fms %12.1f\n", "arcade", arcade.stepMs, arcade.eventsPerStep);
+	Benchmark::printRatio("Box2D 1 thread / arcade", box2dSingle.stepMs, arcade.stepMs);
+	Benchmark::printRatio("Box2D all threads / arcade", box2dThreaded.stepMs, arcade.stepMs);
+
+	JobSystem::Instance().shutdown();
+	return 0;
+}
@@ -0,0 +1,188 @@
+#include "Benchmark.h"
+#include "Engine2000/PhysicsLayerManager.h"
+#include "Engine2000/PhysicsWorld.h"
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Pair filtering: the old custom filter callback, which looked both shapes' layer names
+// up as strings (twice), against b2Filter category and mask bits.
+// Part 1 times the per-pair decision alone over a list of candidate pairs.
+// Part 2 steps the same pile of boxes with each setup, to show what it costs in b2World_Step.
+
+namespace
+{
+	struct ShapeInfo
+	{
+		const char* layerName;	// The old callback kept this in the shape's user data
+		bool sensorEvents;
+		b2Filter filter;
+	};
+
+	// The old PhysicsWorld::filterCallback, minus the Box2D getters, kept here only for comparison
+	bool filterByName(const ShapeInfo& a, const ShapeInfo& b)
+	{
+		const PhysicsLayerManager& layers = PhysicsLayerManager::getInstance();
+		if (!layers.shouldLayersCollide(a.layerName, b.layerName))
+		{
+			if (a.sensorEvents || b.sensorEvents)
+				return true;
+		}
+		return layers.shouldLayersCollide(a.layerName, b.layerName);
+	}
+
+	// What Box2D tests for every candidate pair before any callback
+	bool filterByBits(const b2Filter& a, const b2Filter& b)
+	{
+		if (a.groupIndex == b.groupIndex && a.groupIndex != 0)
+			return a.groupIndex > 0;
+		return (a.maskBits & b.categoryBits) != 0 && (a.categoryBits & b.maskBits) != 0;
+	}
+
+	// Gameplay layers from the built-in set; every tenth shape is a sensor
+	std::vector<ShapeInfo> makeShapes(int count)
+	{
+		const PhysicsLayerManager& layers = PhysicsLayerManager::getInstance();
+		const int gameplayLayers[] = { 2, 3, 4, 5 };	// Environment, Player, Enemy, Projectile
+
+		std::vector<ShapeInfo> shapes(count);
+		for (int i = 0; i < count; i++)
+		{
+			int layer = gameplayLayers[i % 4];
+			ShapeInfo& shape = shapes[i];
+			shape.layerName = layers.getLayerName(layer).c_str();
+			shape.sensorEvents = i % 10 == 0;
+			shape.filter.groupIndex = 0;
+			if (shape.sensorEvents)
+			{
+				shape.filter.categoryBits = PhysicsLayerManager::SENSOR_CATEGORY;
+				shape.filter.maskBits = PhysicsLayerManager::ALL_LAYERS;
+			}
+			else
+			{
+				shape.filter.categoryBits = layers.getCategoryBits(layer);
+				shape.filter.maskBits = layers.getMaskBits(layer);
+			}
+		}
+		return shapes;
+	}
+
+	void timePairDecision()
+	{
+		const int shapeCount = 4096;
+		const int pairCount = 1 << 20;
+		std::vector<ShapeInfo> shapes = makeShapes(shapeCount);
+
+		std::mt19937 rng(1234);
+		std::uniform_int_distribution<int> pick(0, shapeCount - 1);
+		std::vector<std::pair<int, int>> pairs(pairCount);
+		for (auto& pair : pairs)
+			pair = { pick(rng), pick(rng) };
+
+		double nameMs = Benchmark::bestOfMs(5, [&]() {
+			uint64_t kept = 0;
+			for (const auto& pair : pairs)
+				kept += filterByName(shapes[pair.first], shapes[pair.second]);
+			Benchmark::keep(kept);
+		});
+		double bitsMs = Benchmark::bestOfMs(5, [&]() {
+			uint64_t kept = 0;
+			for (const auto& pair : pairs)
+				kept += filterByBits(shapes[pair.first].filter, shapes[pair.second].filter);
+			Benchmark::keep(kept);
+		});
+
+		std::printf("Pair decision, %d candidate pairs\n", pairCount);
+		std::printf("%-24s %8.2fns\n", "layer names (old)", nameMs * 1e6 / pairCount);
+		std::printf("%-24s %8.2fns\n", "b2Filter bits", bitsMs * 1e6 / pairCount);
+		Benchmark::printRatio("speedup", nameMs, bitsMs);
+	}
+
+	bool filterCallback(b2ShapeId shapeIdA, b2ShapeId shapeIdB, void* context)
+	{
+		const ShapeInfo* a = static_cast<const ShapeInfo*>(b2Shape_GetUserData(shapeIdA));
+		const ShapeInfo* b = static_cast<const ShapeInfo*>(b2Shape_GetUserData(shapeIdB));
+		ShapeInfo liveA = *a;
+		ShapeInfo liveB = *b;
+		liveA.sensorEvents = b2Shape_AreSensorEventsEnabled(shapeIdA);
+		liveB.sensorEvents = b2Shape_AreSensorEventsEnabled(shapeIdB);
+		return filterByName(liveA, liveB);
+	}
+
+	// Average b2World_Step ms for a pile of solid boxes on the gameplay layers.
+	// The old setup leaves the default filter on every shape and installs the callback
+	double timeSteps(const std::vector<ShapeInfo>& shapes, bool byName)
+	{
+		const int warmupSteps = 30;
+		const int measuredSteps = 120;
+		const int columns = static_cast<int>(std::sqrt(static_cast<float>(shapes.size())));
+		const float pitWidth = columns * 1.5f;
+
+		PhysicsWorld world;
+		world.init(pitWidth, pitWidth, Vector2D(0.0f, -10.0f), 1);
+		if (byName)
+			b2World_SetCustomFilterCallback(world.getWorldId(), filterCallback, nullptr);
+
+		b2BodyId floor = world.createBody(Vector2D(pitWidth / 2.0f, -0.5f), false);
+		world.createBoxShape(floor, pitWidth + 2.0f, 1.0f);
+
+		b2Polygon box = b2MakeBox(0.5f, 0.5f);
+		for (size_t i = 0; i < shapes.size(); i++)
+		{
+			float x = 0.75f + (i % columns) * 1.5f;
+			float y = 1.0f + (i / columns) * 1.5f;
+			b2BodyId body = world.createBody(Vector2D(x, y), true);
+
+			b2ShapeDef shapeDef = b2DefaultShapeDef();
+			shapeDef.userData = const_cast<ShapeInfo*>(&shapes[i]);
+			// PhysicsWorld reads event shapes' user data as components, and these have none
+			shapeDef.enableContactEvents = false;
+			if (!byName)
+				shapeDef.filter = shapes[i].filter;
+			b2CreatePolygonShape(body, &shapeDef, &box);
+		}
+
+		for (int i = 0; i < warmupSteps; i++)
+			world.update(1.0f / 60.0f);
+
+		double totalMs = 0.0;
+		for (int i = 0; i < measuredSteps; i++)
+		{
+			world.update(1.0f / 60.0f);
+			totalMs += b2World_GetProfile(world.getWorldId()).step;
+		}
+		world.cleanup();
+		return totalMs / measuredSteps;
+	}
+
+	void timeWorldStep()
+	{
+		// Solid shapes only, so both setups simulate the same contacts
+		std::vector<ShapeInfo> shapes = makeShapes(5000);
+		for (ShapeInfo& shape : shapes)
+		{
+			if (shape.sensorEvents)
+			{
+				shape.sensorEvents = false;
+				shape.filter.categoryBits = PhysicsLayerManager::getInstance().getCategoryBits(3);
+				shape.filter.maskBits = PhysicsLayerManager::getInstance().getMaskBits(3);
+				shape.layerName = PhysicsLayerManager::getInstance().getLayerName(3).c_str();
+			}
+		}
+
+		double nameMs = timeSteps(shapes, true);
+		double bitsMs = timeSteps(shapes, false);
+
+		std::printf("\nb2World_Step, %d bodies, one thread\n", static_cast<int>(shapes.size()));
+		std::printf("%-24s %8.3fms\n", "filter callback (old)", nameMs);
+		std::printf("%-24s %8.3fms\n", "b2Filter bits", bitsMs);
+		Benchmark::printRatio("speedup", nameMs, bitsMs);
+	}
+}
+
+int main()
+{
+	timePairDecision();
+	timeWorldStep();
+	return 0;
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "Engine2000/JobSystem.h"
+#include "Engine2000/PhysicsWorld.h"
+#include <cmath>
+
+// b2World_Step time for a pile of dynamic boxes settling in a walled pit, by body
+// count and thread count. Steps go through PhysicsWorld::update so Box2D's tasks run
+// on the job system exactly as in the game; the time reported is Box2D's own step
+// profile, averaged over the measured steps.
+
+namespace
+{
+	const int WARMUP_STEPS = 30;
+	const int MEASURED_STEPS = 120;
+	const float DELTA_TIME = 1.0f / 60.0f;
+
+	void addWall(PhysicsWorld& world, float x, float y, float width, float height)
+	{
+		b2BodyId wall = world.createBody(Vector2D(x, y), false);
+		world.createBoxShape(wall, width, height);
+	}
+
+	// Average step time in ms and the workers PhysicsWorld actually used
+	double timeSteps(int bodyCount, int threadCount, int& workersUsed)
+	{
+		const int columns = static_cast<int>(std::sqrt(static_cast<float>(bodyCount)));
+		const float pitWidth = columns * 1.5f;
+
+		PhysicsWorld world;
+		world.init(pitWidth, pitWidth, Vector2D(0.0f, -10.0f), threadCount);
+		workersUsed = world.getWorkerCount();
+
+		addWall(world, pitWidth / 2.0f, -0.5f, pitWidth + 2.0f, 1.0f);
+		addWall(world, -0.5f, pitWidth * 2.0f, 1.0f, pitWidth * 4.0f);
+		addWall(world, pitWidth + 0.5f, pitWidth * 2.0f, 1.0f, pitWidth * 4.0f);
+
+		for (int i = 0; i < bodyCount; i++)
+		{
+			float x = 0.75f + (i % columns) * 1.5f;
+			float y = 1.0f + (i / columns) * 1.5f;
+			b2BodyId body = world.createBody(Vector2D(x, y), true);
+			world.createBoxShape(body, 1.0f, 1.0f);
+		}
+
+		for (int i = 0; i < WARMUP_STEPS; i++)
+			world.update(DELTA_TIME);
+
+		double totalMs = 0.0;
+		for (int i = 0; i < MEASURED_STEPS; i++)
+		{
+			world.update(DELTA_TIME);
+			totalMs += b2World_GetProfile(world.getWorldId()).step;
+		}
+		world.cleanup();
+		return totalMs / MEASURED_STEPS;
+	}
+}
+
+int main()
+{
+	// Seven workers plus the main thread covers the largest thread count
+	JobSystem::Instance().init(7);
+
+	const int bodyCounts[] = { 1000, 5000, 20000 };
+	const int threadCounts[] = { 1, 2, 4, 8 };
+	const int rows = sizeof(bodyCounts) / sizeof(bodyCounts[0]);
+	const int columns = sizeof(threadCounts) / sizeof(threadCounts[0]);
+
+	// Measured first and printed after, as PhysicsWorld::init logs
+	double stepMs[rows][columns];
+	int workersUsed[rows][columns];
+	for (int row = 0; row < rows; row++)
+		for (int column = 0; column < columns; column++)
+			stepMs[row][column] = timeSteps(bodyCounts[row], threadCounts[column], workersUsed[row][column]);
+
+	std::printf("\nb2World_Step, ms per step (average of %d)\n", MEASURED_STEPS);
+	std::printf("%-8s", "bodies");
+	for (int threads : threadCounts)
+		std::printf(" %7d thr", threads);
+	std::printf(" %10s\n", "8 vs 1");
+	for (int row = 0; row < rows; row++)
+	{
+		std::printf("%-8d", bodyCounts[row]);
+		for (int column = 0; column < columns; column++)
+		{
+			bool capped = workersUsed[row][column] < threadCounts[column];
+			std::printf(" %8.3fms%s", stepMs[row][column], capped ? "*" : " ");
+		}
+		std::printf(" %9.2fx\n", stepMs[row][0] / stepMs[row][columns - 1]);
+	}
+	std::printf("* fewer threads than asked: capped at the job system's threads\n");
+
+	JobSystem::Instance().shutdown();
+	return 0;
+}
@@ -2,9 +2,9 @@
 
 out vec4 FragColor;
 in vec2 TexCoord;
+in vec4 Color;
 
 uniform sampler2D mainTexture;
-uniform vec4 color;
 
 void main()
 {
@@ -14,5 +14,5 @@ void main()
 	if (texColor.r >= 0.95 && texColor.b >= 0.95 && texColor.g <= 0.05)
 		discard;
 
-	FragColor = texColor * color;
+	FragColor = texColor * Color;
 }
\ No newline at end of file
@@ -2,14 +2,16 @@
 
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColor;
 
 out vec2 TexCoord;
+out vec4 Color;
 
 uniform mat4 projection;
-uniform mat4 model;
 
 void main()
 {
-	gl_Position = projection * model * vec4(aPos, 0.0, 1.0);
+	gl_Position = projection * vec4(aPos, 0.0, 1.0);
 	TexCoord = aTexCoord;
+	Color = aColor;
 }
\ No newline at end of file
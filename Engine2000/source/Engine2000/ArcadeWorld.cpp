@@ -0,0 +1,468 @@
+#include "ArcadeWorld.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+namespace
+{
+	// A shape covering more cells than this goes on the large list instead of the grid
+	const int MAX_CELLS_PER_SHAPE = 16;
+
+	// CellEntry::flags, so that pairs that can never report are dropped before the box test
+	const uint32_t ENTRY_SENSOR = 1;
+	const uint32_t ENTRY_SOLID = 2;
+	const uint32_t ENTRY_DYNAMIC = 4;
+
+	inline bool canPair(uint32_t a, uint32_t b)
+	{
+		return ((a & ENTRY_SENSOR) && (b & ENTRY_SOLID))
+			|| ((b & ENTRY_SENSOR) && (a & ENTRY_SOLID))
+			|| ((a & b & ENTRY_SOLID) && ((a | b) & ENTRY_DYNAMIC));
+	}
+
+	// floor() without the library call
+	inline int cellOf(float value, float inverseCellSize)
+	{
+		float scaled = value * inverseCellSize;
+		int cell = static_cast<int>(scaled);
+		return cell - (scaled < static_cast<float>(cell) ? 1 : 0);
+	}
+
+	inline uint32_t hashCell(int x, int y)
+	{
+		return static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(y) * 19349663u;
+	}
+
+	inline uint64_t pairKey(int a, int b)
+	{
+		return static_cast<uint64_t>(a) << 32 | static_cast<uint32_t>(b);
+	}
+}
+
+ArcadeWorld::ArcadeWorld()
+	: m_cellSize(64.0f)
+	, m_gridInverseCellSize(1.0f / 64.0f)
+{
+}
+
+int ArcadeWorld::createBody(float x, float y, bool isDynamic, void* userData)
+{
+	int index;
+	if (!m_freeBodies.empty())
+	{
+		index = m_freeBodies.back();
+		m_freeBodies.pop_back();
+	}
+	else
+	{
+		index = static_cast<int>(m_bodies.size());
+		m_bodies.push_back(Body());
+		m_bodies[index].generation = 0;
+		m_bodies[index].gridStale = false;
+	}
+
+	Body& body = m_bodies[index];
+	body.x = x;
+	body.y = y;
+	body.vx = 0.0f;
+	body.vy = 0.0f;
+	body.userData = userData;
+	body.firstShape = -1;
+	body.alive = true;
+	body.enabled = true;
+	body.isDynamic = isDynamic;
+	markBodyMoved(index);
+	return index;
+}
+
+void ArcadeWorld::destroyBody(int index)
+{
+	Body& body = m_bodies[index];
+	if (!body.alive) return;
+
+	// Like Box2D, the body takes its shapes with it
+	while (body.firstShape >= 0)
+	{
+		destroyShape(body.firstShape);
+	}
+
+	body.alive = false;
+	body.generation++;
+	m_freeBodies.push_back(index);
+}
+
+int ArcadeWorld::createShape(int bodyIndex, float offsetX, float offsetY, float width, float height,
+	bool isSensor, uint64_t categoryBits, uint64_t maskBits, void* userData)
+{
+	int index;
+	if (!m_freeShapes.empty())
+	{
+		index = m_freeShapes.back();
+		m_freeShapes.pop_back();
+	}
+	else
+	{
+		index = static_cast<int>(m_shapes.size());
+		m_shapes.push_back(Shape());
+		m_shapes[index].generation = 0;
+	}
+
+	Body& body = m_bodies[bodyIndex];
+	Shape& shape = m_shapes[index];
+	shape.body = bodyIndex;
+	shape.offsetX = offsetX;
+	shape.offsetY = offsetY;
+	shape.width = width;
+	shape.height = height;
+	shape.categoryBits = categoryBits;
+	shape.maskBits = maskBits;
+	shape.userData = userData;
+	shape.alive = true;
+	shape.isSensor = isSensor;
+	shape.sensorEvents = isSensor;
+	shape.nextShape = body.firstShape;
+	body.firstShape = index;
+	markBodyMoved(bodyIndex);
+	return index;
+}
+
+void ArcadeWorld::destroyShape(int index)
+{
+	Shape& shape = m_shapes[index];
+	if (!shape.alive) return;
+
+	// Unlink from the body's list
+	Body& body = m_bodies[shape.body];
+	if (body.firstShape == index)
+	{
+		body.firstShape = shape.nextShape;
+	}
+	else
+	{
+		for (int i = body.firstShape; i >= 0; i = m_shapes[i].nextShape)
+		{
+			if (m_shapes[i].nextShape == index)
+			{
+				m_shapes[i].nextShape = shape.nextShape;
+				break;
+			}
+		}
+	}
+
+	shape.alive = false;
+	shape.generation++;
+	shape.nextShape = -1;
+	m_releasedShapes.push_back(index);
+}
+
+void ArcadeWorld::markBodyMoved(int index)
+{
+	Body& body = m_bodies[index];
+	if (body.gridStale) return;
+	body.gridStale = true;
+	m_staleBodies.push_back(index);
+}
+
+bool ArcadeWorld::isBodyValid(int body, uint16_t generation) const
+{
+	return body >= 0 && body < static_cast<int>(m_bodies.size())
+		&& m_bodies[body].alive && m_bodies[body].generation == generation;
+}
+
+bool ArcadeWorld::isShapeValid(int shape, uint16_t generation) const
+{
+	return shape >= 0 && shape < static_cast<int>(m_shapes.size())
+		&& m_shapes[shape].alive && m_shapes[shape].generation == generation;
+}
+
+void ArcadeWorld::step(float timeStep)
+{
+	integrate(timeStep);
+
+	{
+		E2_PROFILE_SCOPE("ArcadeWorld::findPairs");
+		findPairs();
+	}
+
+	m_pairEvents.clear();
+	diffPairs(m_previousSensorPairs, m_sensorPairs, true);
+	diffPairs(m_previousContactPairs, m_contactPairs, false);
+
+	// Their pairs are gone from the current lists, so the slots are safe to hand out again
+	m_freeShapes.insert(m_freeShapes.end(), m_releasedShapes.begin(), m_releasedShapes.end());
+	m_releasedShapes.clear();
+}
+
+void ArcadeWorld::integrate(float timeStep)
+{
+	m_moved.clear();
+	for (int i = 0; i < static_cast<int>(m_bodies.size()); i++)
+	{
+		Body& body = m_bodies[i];
+		if (!body.alive || !body.enabled || (body.vx == 0.0f && body.vy == 0.0f)) continue;
+
+		body.x += body.vx * timeStep;
+		body.y += body.vy * timeStep;
+		m_moved.push_back(i);
+	}
+}
+
+void ArcadeWorld::findPairs()
+{
+	m_previousSensorPairs.swap(m_sensorPairs);
+	m_previousContactPairs.swap(m_contactPairs);
+	m_sensorPairs.clear();
+	m_contactPairs.clear();
+
+	// Every body is hashed again below
+	for (int body : m_staleBodies)
+	{
+		m_bodies[body].gridStale = false;
+	}
+	m_staleBodies.clear();
+
+	const float inverseCellSize = 1.0f / m_cellSize;
+	m_gridInverseCellSize = inverseCellSize;
+	const int shapeCount = static_cast<int>(m_shapes.size());
+	m_bounds.resize(static_cast<size_t>(shapeCount) * 4);
+	m_active.clear();
+	m_large.clear();
+	m_entries.clear();
+
+	for (int i = 0; i < shapeCount; i++)
+	{
+		const Shape& shape = m_shapes[i];
+		if (!shape.alive) continue;
+		const Body& body = m_bodies[shape.body];
+		if (!body.enabled) continue;
+		// A sensor with its events off can take part in nothing, but queries still find it
+		const bool pairs = !shape.isSensor || shape.sensorEvents;
+		uint32_t flags = pairs ? (shape.isSensor ? ENTRY_SENSOR : ENTRY_SOLID) | (body.isDynamic ? ENTRY_DYNAMIC : 0) : 0;
+
+		float* bounds = &m_bounds[static_cast<size_t>(i) * 4];
+		bounds[0] = body.x + shape.offsetX;
+		bounds[1] = body.y + shape.offsetY;
+		bounds[2] = bounds[0] + shape.width;
+		bounds[3] = bounds[1] + shape.height;
+		if (pairs) m_active.push_back(i);
+
+		int x0 = cellOf(bounds[0], inverseCellSize);
+		int y0 = cellOf(bounds[1], inverseCellSize);
+		int x1 = cellOf(bounds[2], inverseCellSize);
+		int y1 = cellOf(bounds[3], inverseCellSize);
+		if ((x1 - x0 + 1) * (y1 - y0 + 1) > MAX_CELLS_PER_SHAPE)
+		{
+			m_large.push_back(i);
+			continue;
+		}
+
+		// Each entry carries the bounds, so the pair loop below stays within m_sorted
+		for (int y = y0; y <= y1; y++)
+		{
+			for (int x = x0; x <= x1; x++)
+			{
+				m_entries.push_back({ bounds[0], bounds[1], bounds[2], bounds[3], x, y, i, flags });
+			}
+		}
+	}
+
+	// Counting sort of the entries into hash buckets, about one entry per bucket
+	size_t bucketCount = 64;
+	while (bucketCount < m_entries.size()) bucketCount <<= 1;
+	const uint32_t bucketMask = static_cast<uint32_t>(bucketCount - 1);
+
+	m_bucketStart.assign(bucketCount + 1, 0);
+	for (const CellEntry& entry : m_entries)
+	{
+		m_bucketStart[(hashCell(entry.cellX, entry.cellY) & bucketMask) + 1]++;
+	}
+	for (size_t i = 1; i <= bucketCount; i++)
+	{
+		m_bucketStart[i] += m_bucketStart[i - 1];
+	}
+	m_sorted.resize(m_entries.size());
+	for (const CellEntry& entry : m_entries)
+	{
+		m_sorted[m_bucketStart[hashCell(entry.cellX, entry.cellY) & bucketMask]++] = entry;
+	}
+	// Scattering advanced each start to the next bucket's; shift back
+	for (size_t i = bucketCount; i > 0; i--)
+	{
+		m_bucketStart[i] = m_bucketStart[i - 1];
+	}
+	m_bucketStart[0] = 0;
+
+	const CellEntry* sorted = m_sorted.data();
+	for (size_t bucket = 0; bucket < bucketCount; bucket++)
+	{
+		const int begin = m_bucketStart[bucket];
+		const int end = m_bucketStart[bucket + 1];
+		for (int i = begin; i < end; i++)
+		{
+			const CellEntry& first = sorted[i];
+			for (int j = i + 1; j < end; j++)
+			{
+				const CellEntry& second = sorted[j];
+				// Evaluated without branching; most candidates fail and the branch is then predictable.
+				// Other cells can land in the same bucket, hence the cell test
+				bool overlap = (first.minX < second.maxX) & (second.minX < first.maxX)
+					& (first.minY < second.maxY) & (second.minY < first.maxY)
+					& (first.cellX == second.cellX) & (first.cellY == second.cellY);
+				if (!overlap || !canPair(first.flags, second.flags)) continue;
+
+				// Shapes sharing several cells are tested only in the cell holding the
+				// top-left corner of their overlap, which both of them cover
+				if (cellOf(std::max(first.minX, second.minX), inverseCellSize) != first.cellX
+					|| cellOf(std::max(first.minY, second.minY), inverseCellSize) != first.cellY) continue;
+
+				addPair(first.shape, second.shape);
+			}
+		}
+	}
+
+	// Large shapes (backgrounds, screen-wide triggers) against everything else;
+	// two large shapes are tested from the earlier one only
+	m_largeOrder.assign(shapeCount, -1);
+	for (size_t i = 0; i < m_large.size(); i++)
+	{
+		m_largeOrder[m_large[i]] = static_cast<int>(i);
+	}
+	for (size_t i = 0; i < m_large.size(); i++)
+	{
+		const int large = m_large[i];
+		for (int other : m_active)
+		{
+			if (m_largeOrder[other] >= 0 && m_largeOrder[other] <= static_cast<int>(i)) continue;
+
+			const float* a = &m_bounds[static_cast<size_t>(large) * 4];
+			const float* b = &m_bounds[static_cast<size_t>(other) * 4];
+			if (a[0] >= b[2] || b[0] >= a[2] || a[1] >= b[3] || b[1] >= a[3]) continue;
+			addPair(large, other);
+		}
+	}
+
+	std::sort(m_sensorPairs.begin(), m_sensorPairs.end());
+	std::sort(m_contactPairs.begin(), m_contactPairs.end());
+}
+
+void ArcadeWorld::queryBox(float minX, float minY, float maxX, float maxY, QueryCallback* visit, void* context) const
+{
+	// Bodies changed since the last step are not where the grid has them, so they are
+	// visited from their own list and skipped in the grid and the large list
+	for (int bodyIndex : m_staleBodies)
+	{
+		const Body& body = m_bodies[bodyIndex];
+		if (!body.alive) continue;
+		for (int shape = body.firstShape; shape >= 0; shape = m_shapes[shape].nextShape)
+		{
+			if (!visit(shape, context)) return;
+		}
+	}
+
+	for (int large : m_large)
+	{
+		const Shape& shape = m_shapes[large];
+		if (!shape.alive || m_bodies[shape.body].gridStale) continue;
+		if (!visit(large, context)) return;
+	}
+
+	if (m_sorted.empty()) return;
+
+	// A shape in several cells is reported from the cell holding the top-left corner of
+	// its overlap with the rectangle, as findPairs does for pairs
+	const float inverseCellSize = m_gridInverseCellSize;
+	auto visitEntry = [&](const CellEntry& entry) {
+		if (entry.minX > maxX || entry.maxX < minX || entry.minY > maxY || entry.maxY < minY) return true;
+		if (cellOf(std::max(entry.minX, minX), inverseCellSize) != entry.cellX
+			|| cellOf(std::max(entry.minY, minY), inverseCellSize) != entry.cellY) return true;
+
+		// Slots freed since the step may hold a new shape, whose body is then stale
+		const Shape& shape = m_shapes[entry.shape];
+		if (!shape.alive || m_bodies[shape.body].gridStale) return true;
+		return visit(entry.shape, context);
+	};
+
+	const int x0 = cellOf(minX, inverseCellSize);
+	const int y0 = cellOf(minY, inverseCellSize);
+	const int x1 = cellOf(maxX, inverseCellSize);
+	const int y1 = cellOf(maxY, inverseCellSize);
+
+	// A rectangle covering more cells than there are entries is cheaper to test against all of them
+	const int64_t cellCount = static_cast<int64_t>(x1 - x0 + 1) * (y1 - y0 + 1);
+	if (cellCount > static_cast<int64_t>(m_sorted.size()))
+	{
+		for (const CellEntry& entry : m_sorted)
+		{
+			if (!visitEntry(entry)) return;
+		}
+		return;
+	}
+
+	const uint32_t bucketMask = static_cast<uint32_t>(m_bucketStart.size() - 2);
+	for (int y = y0; y <= y1; y++)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			const uint32_t bucket = hashCell(x, y) & bucketMask;
+			for (int i = m_bucketStart[bucket]; i < m_bucketStart[bucket + 1]; i++)
+			{
+				const CellEntry& entry = m_sorted[i];
+				if (entry.cellX != x || entry.cellY != y) continue;
+				if (!visitEntry(entry)) return;
+			}
+		}
+	}
+}
+
+void ArcadeWorld::addPair(int indexA, int indexB)
+{
+	// The boxes overlap; what is left are the pairing rules
+	const Shape& a = m_shapes[indexA];
+	const Shape& b = m_shapes[indexB];
+	if (a.body == b.body) return;
+	if (a.isSensor && b.isSensor) return;
+	if ((a.categoryBits & b.maskBits) == 0 || (b.categoryBits & a.maskBits) == 0) return;
+
+	if (a.isSensor)
+	{
+		if (a.sensorEvents) m_sensorPairs.push_back(pairKey(indexA, indexB));
+	}
+	else if (b.isSensor)
+	{
+		if (b.sensorEvents) m_sensorPairs.push_back(pairKey(indexB, indexA));
+	}
+	else if (m_bodies[a.body].isDynamic || m_bodies[b.body].isDynamic)
+	{
+		m_contactPairs.push_back(pairKey(std::min(indexA, indexB), std::max(indexA, indexB)));
+	}
+}
+
+void ArcadeWorld::diffPairs(const std::vector<uint64_t>& previous, const std::vector<uint64_t>& current, bool isSensor)
+{
+	auto emit = [this, isSensor](uint64_t key, bool begin) {
+		int a = static_cast<int>(key >> 32);
+		int b = static_cast<int>(key & 0xFFFFFFFFu);
+		if (!begin && (!m_shapes[a].alive || !m_shapes[b].alive)) return;
+		m_pairEvents.push_back({ a, b, isSensor, begin });
+	};
+
+	// Both lists are sorted: one merge finds the pairs only in one of them
+	size_t i = 0;
+	size_t j = 0;
+	while (i < previous.size() || j < current.size())
+	{
+		if (j == current.size() || (i < previous.size() && previous[i] < current[j]))
+		{
+			emit(previous[i++], false);
+		}
+		else if (i == previous.size() || current[j] < previous[i])
+		{
+			emit(current[j++], true);
+		}
+		else
+		{
+			i++;
+			j++;
+		}
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Overlap-only physics for PhysicsBackend::Arcade. Bodies move by their velocity,
+// shapes are axis-aligned boxes, and a spatial hash finds the pairs that overlap;
+// there are no forces and no collision response. Pairs follow Box2D's rules: the
+// filter bits must accept each other, a sensor reports solid shapes on other bodies,
+// and two solid shapes touch only if one of them is on a dynamic body.
+// PhysicsWorld wraps the indices returned here in b2BodyId/b2ShapeId.
+class ArcadeWorld
+{
+public:
+	struct Shape
+	{
+		int body;
+		float offsetX, offsetY;	// From the body position to the box's top-left corner
+		float width, height;
+		uint64_t categoryBits;
+		uint64_t maskBits;
+		void* userData;
+		int nextShape;			// On the same body, -1 at the end
+		uint16_t generation;
+		bool alive;
+		bool isSensor;
+		bool sensorEvents;
+	};
+
+	struct Body
+	{
+		float x, y;
+		float vx, vy;
+		void* userData;
+		int firstShape;
+		uint16_t generation;
+		bool alive;
+		bool enabled;
+		bool isDynamic;
+		bool gridStale;			// Changed since the last step, so not where the query grid has it
+	};
+
+	// Shapes are indices; for a sensor pair a is the sensor and b the visitor
+	struct PairEvent
+	{
+		int shapeA;
+		int shapeB;
+		bool isSensor;
+		bool begin;
+	};
+
+	ArcadeWorld();
+
+	// Pairs are searched in square cells of this size; about the size of a typical shape
+	void setCellSize(float size) { m_cellSize = size > 0.0f ? size : 64.0f; }
+
+	int createBody(float x, float y, bool isDynamic, void* userData);
+	void destroyBody(int body);
+	int createShape(int body, float offsetX, float offsetY, float width, float height,
+		bool isSensor, uint64_t categoryBits, uint64_t maskBits, void* userData);
+	void destroyShape(int shape);
+
+	// After writing a body's position or enabled flag outside step(), so that
+	// queryBox looks for its shapes outside the grid until the next step
+	void markBodyMoved(int body);
+
+	bool isBodyValid(int body, uint16_t generation) const;
+	bool isShapeValid(int shape, uint16_t generation) const;
+
+	const Body& getBody(int body) const { return m_bodies[body]; }
+	const Shape& getShape(int shape) const { return m_shapes[shape]; }
+	// Shape slots in use or free; scan with alive and the body's enabled flag
+	int getShapeSlotCount() const { return static_cast<int>(m_shapes.size()); }
+
+	// Moves the bodies, then finds overlaps and what changed since the last step
+	void step(float timeStep);
+
+	// Calls visit for each shape on a live body whose box may touch the rectangle, once per
+	// shape, until it returns false. The caller tests the shape's current box and flags.
+	// Looks up the cells the last step hashed, plus the large shapes and the bodies marked
+	// since. Any number of threads may query at once, but not while the world steps
+	using QueryCallback = bool(int shape, void* context);
+	void queryBox(float minX, float minY, float maxX, float maxY, QueryCallback* visit, void* context) const;
+
+	// Bodies moved by their velocity in the last step
+	const std::vector<int>& getMovedBodies() const { return m_moved; }
+	// Begins and ends from the last step, sorted; pairs with a destroyed shape end silently
+	const std::vector<PairEvent>& getPairEvents() const { return m_pairEvents; }
+	int getPairCount() const { return static_cast<int>(m_sensorPairs.size() + m_contactPairs.size()); }
+	int getBodyCount() const { return static_cast<int>(m_bodies.size() - m_freeBodies.size()); }
+	int getShapeCount() const { return static_cast<int>(m_shapes.size() - m_freeShapes.size() - m_releasedShapes.size()); }
+
+private:
+	// Writable records are for PhysicsWorld, which keeps them in step with the grid
+	friend class PhysicsWorld;
+	Body& getBody(int body) { return m_bodies[body]; }
+	Shape& getShape(int shape) { return m_shapes[shape]; }
+
+	struct CellEntry
+	{
+		float minX, minY, maxX, maxY;
+		int cellX, cellY;
+		int shape;
+		uint32_t flags;
+	};
+
+	float m_cellSize;
+
+	std::vector<Body> m_bodies;
+	std::vector<Shape> m_shapes;
+	std::vector<int> m_freeBodies;
+	std::vector<int> m_freeShapes;
+	// Freed during a step's callbacks; reused only after the next step has dropped their pairs
+	std::vector<int> m_releasedShapes;
+
+	// Broadphase data, kept between steps so it does not reallocate; the buckets
+	// in m_sorted and m_large also serve queryBox until the next step
+	std::vector<float> m_bounds;	// minX, minY, maxX, maxY per shape
+	std::vector<CellEntry> m_entries;
+	std::vector<CellEntry> m_sorted;
+	std::vector<int> m_bucketStart;
+	float m_gridInverseCellSize;	// 1 / the cell size m_sorted was hashed with
+	std::vector<int> m_active;		// Shapes on enabled bodies this step
+	std::vector<int> m_large;		// Shapes spanning too many cells, tested against all
+	std::vector<int> m_largeOrder;	// Per shape: position in m_large, or -1
+	std::vector<int> m_staleBodies;	// Bodies with gridStale set
+
+	// Current pairs as (a << 32 | b), sorted; the previous step's for the diff
+	std::vector<uint64_t> m_sensorPairs;
+	std::vector<uint64_t> m_contactPairs;
+	std::vector<uint64_t> m_previousSensorPairs;
+	std::vector<uint64_t> m_previousContactPairs;
+
+	std::vector<int> m_moved;
+	std::vector<PairEvent> m_pairEvents;
+
+	void integrate(float timeStep);
+	void findPairs();
+	void addPair(int a, int b);
+	void diffPairs(const std::vector<uint64_t>& previous, const std::vector<uint64_t>& current, bool isSensor);
+};
@@ -1,20 +1,30 @@
 #pragma once
 
 #include "Core.h"
+#include "ComponentType.h"
+#include <cstddef>
+#include <cstdint>
 
 class GameObject;
+template<typename T, size_t ChunkSize> class ComponentPool;
 
 class ENGINE2000_API Component
 {
 protected:
 	GameObject* m_owner;
+	ComponentTypeId m_typeId;	// Set by GameObject::addComponent
+	uint32_t m_poolIndex;		// Slot in the owning pool's live list, when pooled
+
+	friend class GameObject;
+	template<typename T, size_t ChunkSize> friend class ComponentPool;
 
 public:
-	Component(GameObject* owner) : m_owner(owner) {}
+	Component(GameObject* owner) : m_owner(owner), m_typeId(INVALID_COMPONENT_TYPE), m_poolIndex(0) {}
 	virtual ~Component() = default;
 
 	virtual void init() {} 
 	virtual void update(float deltaTime) {}
 	virtual void render() {}
 	GameObject* getOwner() { return m_owner; }
+	ComponentTypeId getTypeId() const { return m_typeId; }
 };
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Component.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Type-homogeneous storage for one component type.
+// Components live in fixed-size chunks so their addresses never move (the
+// pointer held by GameObject is the stable handle). A dense list of live
+// components is kept alongside for linear system passes; removal swaps the
+// last entry into the hole so the list stays packed. Active components sit
+// in front of inactive ones (parked objects), and passes only walk those.
+template<typename T, size_t ChunkSize = 256>
+class ComponentPool
+{
+private:
+	struct Chunk
+	{
+		alignas(T) unsigned char storage[sizeof(T) * ChunkSize];
+	};
+
+	std::vector<std::unique_ptr<Chunk>> m_chunks;
+	std::vector<T*> m_freeSlots;
+	std::vector<T*> m_live;
+	size_t m_activeCount = 0;	// m_live[0, m_activeCount) is active
+
+	void swapLive(uint32_t a, uint32_t b)
+	{
+		std::swap(m_live[a], m_live[b]);
+		m_live[a]->m_poolIndex = a;
+		m_live[b]->m_poolIndex = b;
+	}
+
+	void grow()
+	{
+		m_chunks.push_back(std::make_unique<Chunk>());
+		T* base = reinterpret_cast<T*>(m_chunks.back()->storage);
+
+		// Pushed in reverse so slots are handed out in address order
+		m_freeSlots.reserve(m_freeSlots.size() + ChunkSize);
+		for (size_t i = ChunkSize; i > 0; --i)
+		{
+			m_freeSlots.push_back(base + (i - 1));
+		}
+	}
+
+public:
+	ComponentPool() = default;
+	ComponentPool(const ComponentPool&) = delete;
+	ComponentPool& operator=(const ComponentPool&) = delete;
+
+	~ComponentPool()
+	{
+		// Anything still alive is torn down with the pool
+		for (T* component : m_live)
+		{
+			component->~T();
+		}
+	}
+
+	T* create(GameObject* owner)
+	{
+		if (m_freeSlots.empty())
+		{
+			grow();
+		}
+
+		T* slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+
+		T* component = new (slot) T(owner);
+		component->m_poolIndex = static_cast<uint32_t>(m_live.size());
+		m_live.push_back(component);
+
+		// New components start active
+		swapLive(component->m_poolIndex, static_cast<uint32_t>(m_activeCount));
+		m_activeCount++;
+		return component;
+	}
+
+	void destroy(T* component)
+	{
+		setActive(component, false);
+		uint32_t index = component->m_poolIndex;
+
+		// Swap-remove from the dense list
+		T* last = m_live.back();
+		m_live[index] = last;
+		last->m_poolIndex = index;
+		m_live.pop_back();
+
+		component->~T();
+		m_freeSlots.push_back(component);
+	}
+
+	// Moves the component across the active/inactive boundary
+	void setActive(T* component, bool active)
+	{
+		uint32_t index = component->m_poolIndex;
+		if (active == (index < m_activeCount)) return;
+
+		if (active)
+		{
+			swapLive(index, static_cast<uint32_t>(m_activeCount));
+			m_activeCount++;
+		}
+		else
+		{
+			m_activeCount--;
+			swapLive(index, static_cast<uint32_t>(m_activeCount));
+		}
+	}
+
+	// Active components only
+	template<typename Func>
+	void forEach(Func&& func)
+	{
+		for (size_t i = 0; i < m_activeCount; ++i)
+		{
+			func(*m_live[i]);
+		}
+	}
+
+	size_t size() const { return m_live.size(); }
+	size_t activeCount() const { return m_activeCount; }
+	size_t capacity() const { return m_chunks.size() * ChunkSize; }
+};
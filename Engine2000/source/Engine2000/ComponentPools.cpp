@@ -0,0 +1,88 @@
+#include "ComponentPools.h"
+#include "ComponentPool.h"
+#include "GameObject.h"
+#include "TransformComponent.h"
+#include "SpriteComponent.h"
+#include "PhysicsComponent.h"
+
+class ComponentPools::ComponentPoolsImpl
+{
+public:
+	ComponentPool<TransformComponent> transforms;
+	ComponentPool<SpriteComponent> sprites;
+	ComponentPool<PhysicsComponent> physics;
+
+	ComponentTypeId transformId;
+	ComponentTypeId spriteId;
+	ComponentTypeId physicsId;
+
+	ComponentPoolsImpl()
+		: transformId(getComponentTypeId<TransformComponent>())
+		, spriteId(getComponentTypeId<SpriteComponent>())
+		, physicsId(getComponentTypeId<PhysicsComponent>())
+	{}
+};
+
+ComponentPools& ComponentPools::Instance()
+{
+	static ComponentPools instance;
+	return instance;
+}
+
+ComponentPools::ComponentPools()
+	: pimpl(new ComponentPoolsImpl())
+	, m_enabled(false)
+{}
+
+ComponentPools::~ComponentPools() { delete pimpl; }
+
+Component* ComponentPools::create(ComponentTypeId typeId, GameObject* owner)
+{
+	if (!m_enabled) return nullptr;
+
+	if (typeId == pimpl->transformId) return pimpl->transforms.create(owner);
+	if (typeId == pimpl->spriteId) return pimpl->sprites.create(owner);
+	if (typeId == pimpl->physicsId) return pimpl->physics.create(owner);
+	return nullptr;
+}
+
+void ComponentPools::destroy(Component* component)
+{
+	ComponentTypeId typeId = component->getTypeId();
+
+	if (typeId == pimpl->transformId) pimpl->transforms.destroy(static_cast<TransformComponent*>(component));
+	else if (typeId == pimpl->spriteId) pimpl->sprites.destroy(static_cast<SpriteComponent*>(component));
+	else if (typeId == pimpl->physicsId) pimpl->physics.destroy(static_cast<PhysicsComponent*>(component));
+}
+
+void ComponentPools::setActive(Component* component, bool active)
+{
+	ComponentTypeId typeId = component->getTypeId();
+
+	if (typeId == pimpl->transformId) pimpl->transforms.setActive(static_cast<TransformComponent*>(component), active);
+	else if (typeId == pimpl->spriteId) pimpl->sprites.setActive(static_cast<SpriteComponent*>(component), active);
+	else if (typeId == pimpl->physicsId) pimpl->physics.setActive(static_cast<PhysicsComponent*>(component), active);
+}
+
+void ComponentPools::update(float deltaTime)
+{
+	// Physics first so sprites pick up this frame's body positions.
+	// Transforms have no per-frame work. Only active components are visited, and
+	// dormant objects are skipped as in Level::update.
+	pimpl->physics.forEach([deltaTime](PhysicsComponent& physics) {
+		if (!physics.getOwner()->isDormant()) physics.update(deltaTime);
+	});
+	pimpl->sprites.forEach([deltaTime](SpriteComponent& sprite) {
+		if (!sprite.getOwner()->isDormant()) sprite.update(deltaTime);
+	});
+}
+
+ComponentPoolStats ComponentPools::getStats() const
+{
+	ComponentPoolStats stats;
+	stats.transforms = static_cast<int>(pimpl->transforms.size());
+	stats.sprites = static_cast<int>(pimpl->sprites.size());
+	stats.physics = static_cast<int>(pimpl->physics.size());
+	stats.capacity = static_cast<int>(pimpl->transforms.capacity() + pimpl->sprites.capacity() + pimpl->physics.capacity());
+	return stats;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core.h"
+#include "ComponentType.h"
+
+class Component;
+class GameObject;
+
+struct ComponentPoolStats
+{
+	int transforms = 0;
+	int sprites = 0;
+	int physics = 0;
+	int capacity = 0;	// Slots allocated across all pools
+};
+
+// Opt-in pooled storage for the engine's hot components (Transform, Sprite,
+// Physics). When enabled, GameObject::addComponent takes those types from
+// here instead of the heap, and Level advances them in linear passes
+// rather than through each GameObject.
+class ENGINE2000_API ComponentPools {
+private:
+	// Singleton pattern
+	ComponentPools();
+	~ComponentPools();
+	ComponentPools(const ComponentPools&) = delete;
+	ComponentPools& operator=(const ComponentPools&) = delete;
+
+	class ComponentPoolsImpl;
+	ComponentPoolsImpl* pimpl;
+	bool m_enabled;
+
+public:
+	static ComponentPools& Instance();
+
+	// Must be decided before the first GameObject is created
+	void setEnabled(bool enabled) { m_enabled = enabled; }
+	bool isEnabled() const { return m_enabled; }
+
+	// Returns nullptr when pooling is off or the type is not pooled
+	Component* create(ComponentTypeId typeId, GameObject* owner);
+	void destroy(Component* component);
+
+	// Inactive components stay allocated but are left out of update (Level parks
+	// pooled GameObjects this way)
+	void setActive(Component* component, bool active);
+
+	// Runs the per-frame update of every pooled component, one type at a time
+	void update(float deltaTime);
+
+	ComponentPoolStats getStats() const;
+};
@@ -0,0 +1,50 @@
+#include "ComponentType.h"
+#include "EngineError.h"
+#include "E2Log.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+	struct ComponentTypeRegistry
+	{
+		std::unordered_map<std::string, ComponentTypeId> ids;
+		std::vector<std::string> names;
+	};
+
+	ComponentTypeRegistry& getRegistry()
+	{
+		static ComponentTypeRegistry registry;
+		return registry;
+	}
+}
+
+ComponentTypeId registerComponentType(const char* typeName)
+{
+	ComponentTypeRegistry& registry = getRegistry();
+
+	auto it = registry.ids.find(typeName);
+	if (it != registry.ids.end())
+	{
+		return it->second;
+	}
+
+	if (registry.names.size() >= MAX_COMPONENT_TYPES)
+	{
+		E2_LOG(Error, "Too many component types, cannot register %s", typeName);
+		throw EngineError("Component type limit reached");
+	}
+
+	ComponentTypeId id = static_cast<ComponentTypeId>(registry.names.size());
+	registry.ids.emplace(typeName, id);
+	registry.names.push_back(typeName);
+	return id;
+}
+
+const char* getComponentTypeName(ComponentTypeId id)
+{
+	ComponentTypeRegistry& registry = getRegistry();
+	return id < registry.names.size() ? registry.names[id].c_str() : "Unknown";
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Core.h"
+#include <cstdint>
+#include <typeinfo>
+
+// Small dense ids for component types, used by GameObject for O(1) lookups.
+// Ids are handed out by the engine DLL so the game and engine agree on them.
+using ComponentTypeId = uint32_t;
+
+static constexpr ComponentTypeId MAX_COMPONENT_TYPES = 64;
+static constexpr ComponentTypeId INVALID_COMPONENT_TYPE = MAX_COMPONENT_TYPES;
+
+// Returns the id for a type name, assigning the next free one on first use
+ENGINE2000_API ComponentTypeId registerComponentType(const char* typeName);
+ENGINE2000_API const char* getComponentTypeName(ComponentTypeId id);
+
+// Resolved once per type and cached; lookups afterwards are a static load
+template<typename T>
+ComponentTypeId getComponentTypeId()
+{
+	static const ComponentTypeId id = registerComponentType(typeid(T).name());
+	return id;
+}
+
+// Number of set bits, used to turn a type mask into a dense array index
+inline uint32_t countBits(uint64_t value)
+{
+	value = value - ((value >> 1) & 0x5555555555555555ull);
+	value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+	value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<uint32_t>((value * 0x0101010101010101ull) >> 56);
+}
@@ -6,6 +6,13 @@
 	#else
 		#define ENGINE2000_API __declspec(dllimport)
 	#endif
+#elif defined(__linux__) || defined(__APPLE__)
+	#define E2000_PLATFORM_POSIX
+	#ifdef E2000_BUILD_DLL
+		#define ENGINE2000_API __attribute__((visibility("default")))
+	#else
+		#define ENGINE2000_API
+	#endif
 #else
-	#error Engine2000 only supports Windows!
+	#error Engine2000 only supports Windows and POSIX platforms!
 #endif
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Vector4D.h"
+
+// When a dormant object wakes up (see Level::makeDormant). Triggers combine; with none
+// set the object sleeps until Level::wakeObject is called.
+struct DormancyTrigger
+{
+	float wakeAfter = -1.0f;	// Seconds of dormancy; negative is off
+	bool useRegion = false;		// Wake once the object's position is inside region
+	Vector4D region;			// x, y, w, h in world coordinates
+	bool drift = false;			// Move the transform along the body's velocity while dormant, without simulating it
+};
@@ -1,22 +1,20 @@
 #include "E2Log.h"
-#include <windows.h>
+#include "Platform.h"
 
 void E2Log::setTextColor(Level level) {
-	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
 	switch (level) {
 	case Log:
-		SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+		Platform::setConsoleColor(Platform::ConsoleColor::White);
 		break;
 	case Warning:
-		SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN);
+		Platform::setConsoleColor(Platform::ConsoleColor::Yellow);
 		break;
 	case Error:
-		SetConsoleTextAttribute(hConsole, FOREGROUND_RED);
+		Platform::setConsoleColor(Platform::ConsoleColor::Red);
 		break;
 	}
 }
 
 void E2Log::resetTextColor() {
-	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-	SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+	Platform::setConsoleColor(Platform::ConsoleColor::White);
 }
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 
-#ifdef E2000_PLATFORM_WINDOWS
+#if defined(E2000_PLATFORM_WINDOWS) || defined(E2000_PLATFORM_POSIX)
 
 extern GameEngine* CreateApplication();
 
@@ -8,8 +8,10 @@ int main(int argc, char** argv)
 {
 	printf("Engine2000\n");
 	auto app = CreateApplication();
+	app->parseArguments(argc, argv);
 	app->init();
 	app->run();
+	app->shutdown();
 	delete app;
 }
 
@@ -0,0 +1,159 @@
+#include "FramePacer.h"
+#include "E2Log.h"
+#include "Platform.h"
+
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cmath>
+
+// Sleep this long short of the deadline and spin the rest; SDL_Delay can overshoot by a millisecond or more
+static const double SLEEP_MARGIN_SECONDS = 0.002;
+
+FramePacer::FramePacer()
+	: m_mode(FramePacingMode::VSync)
+	, m_targetFps(60)
+	, m_useOpenGL(true)
+	, m_sdlRenderer(nullptr)
+	, m_frequency(1)
+	, m_lastFrameEnd(0)
+	, m_nextDeadline(0)
+	, m_history(HISTORY_SIZE, 0.0f)
+	, m_historyNext(0)
+	, m_historyCount(0)
+{
+}
+
+void FramePacer::init(FramePacingMode mode, int targetFps, bool useOpenGL, SDL_Renderer* sdlRenderer)
+{
+	m_useOpenGL = useOpenGL;
+	m_sdlRenderer = sdlRenderer;
+	m_frequency = Platform::getCounterFrequency();
+	m_lastFrameEnd = Platform::getCounter();
+	setMode(mode, targetFps);
+}
+
+void FramePacer::setMode(FramePacingMode mode, int targetFps)
+{
+	m_mode = mode;
+	m_targetFps = targetFps > 0 ? targetFps : 60;
+	m_nextDeadline = 0;
+	applySwapInterval();
+}
+
+void FramePacer::resetTiming()
+{
+	m_lastFrameEnd = Platform::getCounter();
+	m_nextDeadline = 0;
+	m_historyNext = 0;
+	m_historyCount = 0;
+}
+
+void FramePacer::applySwapInterval()
+{
+	bool vsync = m_mode == FramePacingMode::VSync || m_mode == FramePacingMode::AdaptiveVSync;
+
+	if (m_useOpenGL)
+	{
+		if (m_mode == FramePacingMode::AdaptiveVSync && SDL_GL_SetSwapInterval(-1) == 0)
+		{
+			return;
+		}
+		if (m_mode == FramePacingMode::AdaptiveVSync)
+		{
+			E2_LOG(Warning, "Adaptive vsync not supported (%s), using vsync", SDL_GetError());
+		}
+
+		if (SDL_GL_SetSwapInterval(vsync ? 1 : 0) != 0)
+		{
+			E2_LOG(Warning, "Failed to set swap interval: %s", SDL_GetError());
+		}
+	}
+	else if (m_sdlRenderer)
+	{
+		// SDL_Renderer has no adaptive mode
+		if (SDL_RenderSetVSync(m_sdlRenderer, vsync ? 1 : 0) != 0)
+		{
+			E2_LOG(Warning, "Failed to set renderer vsync: %s", SDL_GetError());
+		}
+	}
+}
+
+void FramePacer::waitUntil(uint64_t deadline)
+{
+	uint64_t now = Platform::getCounter();
+	if (now >= deadline) return;
+
+	double remaining = static_cast<double>(deadline - now) / m_frequency;
+	if (remaining > SLEEP_MARGIN_SECONDS)
+	{
+		SDL_Delay(static_cast<Uint32>((remaining - SLEEP_MARGIN_SECONDS) * 1000.0));
+	}
+
+	while (Platform::getCounter() < deadline)
+	{
+		// Spin out the last stretch for an accurate frame boundary
+	}
+}
+
+void FramePacer::endFrame()
+{
+	if (m_mode == FramePacingMode::FixedFPS)
+	{
+		uint64_t period = m_frequency / m_targetFps;
+		uint64_t now = Platform::getCounter();
+
+		// Deadlines advance by whole periods so the average rate holds; after a long frame, resync
+		if (m_nextDeadline == 0 || now > m_nextDeadline + period)
+		{
+			m_nextDeadline = now + period;
+		}
+		waitUntil(m_nextDeadline);
+		m_nextDeadline += period;
+	}
+
+	uint64_t frameEnd = Platform::getCounter();
+	m_history[m_historyNext] = static_cast<float>((frameEnd - m_lastFrameEnd) * 1000.0 / m_frequency);
+	m_historyNext = (m_historyNext + 1) % HISTORY_SIZE;
+	m_historyCount = std::min(m_historyCount + 1, HISTORY_SIZE);
+	m_lastFrameEnd = frameEnd;
+}
+
+FrameTimeStats FramePacer::getStats() const
+{
+	FrameTimeStats stats;
+	if (m_historyCount == 0) return stats;
+
+	std::vector<float> samples(m_history.begin(), m_history.begin() + m_historyCount);
+	std::sort(samples.begin(), samples.end());
+
+	double sum = 0.0;
+	for (float sample : samples)
+	{
+		sum += sample;
+	}
+	double mean = sum / samples.size();
+
+	double variance = 0.0;
+	for (float sample : samples)
+	{
+		variance += (sample - mean) * (sample - mean);
+	}
+	variance /= samples.size();
+
+	size_t p99Index = std::min(samples.size() - 1, static_cast<size_t>(std::ceil(samples.size() * 0.99)) - 1);
+
+	stats.mean = static_cast<float>(mean);
+	stats.p99 = samples[p99Index];
+	stats.jitter = static_cast<float>(std::sqrt(variance));
+	stats.min = samples.front();
+	stats.max = samples.back();
+	stats.samples = m_historyCount;
+	return stats;
+}
+
+void FramePacer::logStats() const
+{
+	FrameTimeStats stats = getStats();
+	E2_LOG(Log, "Frame time over %d frames: mean %.2f ms, p99 %.2f ms, jitter %.2f ms (min %.2f, max %.2f)",
+		stats.samples, stats.mean, stats.p99, stats.jitter, stats.min, stats.max);
+}
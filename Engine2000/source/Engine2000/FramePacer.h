@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+struct SDL_Renderer;
+
+enum class FramePacingMode
+{
+	VSync,			// Wait for the display's vertical blank
+	AdaptiveVSync,	// VSync, but late frames are shown immediately instead of waiting a whole refresh
+	FixedFPS,		// Sleep, then spin, up to a target frame rate; no vsync
+	Unlimited		// No waiting at all; for benchmarks
+};
+
+// Frame-to-frame times over the recent history, in milliseconds
+struct FrameTimeStats
+{
+	float mean = 0.0f;
+	float p99 = 0.0f;
+	float jitter = 0.0f;	// Standard deviation
+	float min = 0.0f;
+	float max = 0.0f;
+	int samples = 0;
+};
+
+// Sets the swap interval for the active backend and limits the frame rate,
+// so the main loop does not spin a core rendering identical frames.
+class FramePacer {
+private:
+	static constexpr int HISTORY_SIZE = 240;
+
+	FramePacingMode m_mode;
+	int m_targetFps;
+	bool m_useOpenGL;
+	SDL_Renderer* m_sdlRenderer;
+
+	uint64_t m_frequency;
+	uint64_t m_lastFrameEnd;
+	uint64_t m_nextDeadline;
+
+	std::vector<float> m_history;	// Ring buffer of frame times
+	int m_historyNext;
+	int m_historyCount;
+
+	void applySwapInterval();
+	void waitUntil(uint64_t deadline);
+
+public:
+	FramePacer();
+
+	void init(FramePacingMode mode, int targetFps, bool useOpenGL, SDL_Renderer* sdlRenderer);
+	void setMode(FramePacingMode mode, int targetFps);
+	FramePacingMode getMode() const { return m_mode; }
+	int getTargetFps() const { return m_targetFps; }
+
+	// Restarts the frame clock and history, e.g. after loading
+	void resetTiming();
+
+	// Call once per frame after present: waits in FixedFPS mode and records the frame time
+	void endFrame();
+
+	FrameTimeStats getStats() const;
+	void logStats() const;
+};
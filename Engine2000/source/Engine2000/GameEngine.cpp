@@ -2,15 +2,34 @@
 #include "EngineError.h"
 #include "Window.h"
 #include "Renderer.h"
+#include "TextureCache.h"
+#include "TextureAtlas.h"
+#include "ComponentPools.h"
+#include "E2Log.h"
+#include "Platform.h"
+#include "Profiler.h"
+#include "JobSystem.h"
 #include "Level.h"
+#include "PhysicsWorld.h"
 #include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
 #include <iostream>
 
 GameEngine::GameEngine(const Settings& settings)
 	: m_settings(settings)
 	, m_isRunning(false)
 	, m_window(nullptr)
+	, m_framePacer(nullptr)
 	, m_currentLevel(nullptr)
+	, m_deltaTime(0.0f)
+	, m_frameTime(0.0f)
+	, m_accumulator(0.0f)
+	, m_interpolationAlpha(1.0f)
+	, m_prevCounter(0)
+	, m_frameCount(0)
+	, m_statsFile(nullptr)
 {
 }
 
@@ -22,23 +41,146 @@ GameEngine::~GameEngine()
 	}
 }
 
+void GameEngine::parseArguments(int argc, char** argv)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if (arg == "--headless")
+		{
+			m_settings.headless = true;
+		}
+		else if (arg == "--frames" && i + 1 < argc)
+		{
+			m_settings.maxFrames = std::max(0, atoi(argv[++i]));
+		}
+		else if (arg == "--trace" && i + 1 < argc)
+		{
+			m_settings.traceFrames = std::max(0, atoi(argv[++i]));
+			if (i + 1 < argc && argv[i + 1][0] != '-')
+			{
+				m_settings.tracePath = argv[++i];
+			}
+		}
+		else if (arg == "--threads" && i + 1 < argc)
+		{
+			m_settings.workerThreads = atoi(argv[++i]);
+		}
+		else if (arg == "--physics" && i + 1 < argc)
+		{
+			std::string backend = argv[++i];
+			if (backend == "arcade")
+			{
+				m_settings.physicsBackend = PhysicsBackend::Arcade;
+			}
+			else if (backend == "box2d")
+			{
+				m_settings.physicsBackend = PhysicsBackend::Box2D;
+			}
+			else
+			{
+				E2_LOG(Warning, "Unknown physics backend: %s", backend.c_str());
+			}
+		}
+		else if (arg == "--stats-file" && i + 1 < argc)
+		{
+			m_settings.statsPath = argv[++i];
+		}
+		else if (arg == "--physics-overlay")
+		{
+			m_settings.physicsOverlay = true;
+		}
+		else if (arg == "--record" && i + 1 < argc)
+		{
+			m_settings.recordInputPath = argv[++i];
+		}
+		else if (arg == "--replay" && i + 1 < argc)
+		{
+			m_settings.replayInputPath = argv[++i];
+		}
+		else
+		{
+			E2_LOG(Warning, "Unknown argument: %s", arg.c_str());
+		}
+	}
+}
+
 void GameEngine::init()
 {
-	if (SDL_Init(SDL_INIT_EVERYTHING) < 0)
+	// Headless boxes have no display, so video (and everything needing it) stays off
+	Uint32 sdlFlags = m_settings.headless ? (SDL_INIT_TIMER | SDL_INIT_EVENTS) : SDL_INIT_EVERYTHING;
+	if (SDL_Init(sdlFlags) < 0)
 	{
 		throw EngineError();
 	}
 
-	m_window = new Window(m_settings.title, m_settings.width, m_settings.height, m_settings.useOpenGL);
+	if (m_settings.headless)
+	{
+		Renderer::Instance().init(nullptr, RenderBackend::Null);
+		m_settings.framePacing = FramePacingMode::Unlimited;
+	}
+	else
+	{
+		m_window = new Window(m_settings.title, m_settings.width, m_settings.height, m_settings.useOpenGL);
+
+		// Initialize renderer
+		Renderer::Instance().init(m_window, m_settings.useOpenGL ? RenderBackend::OpenGL : RenderBackend::SDL);
+	}
 
-	// Initialize renderer
-	Renderer::Instance().init(m_window, m_settings.useOpenGL);
+	// Swap interval needs the GL context / SDL renderer to exist
+	m_framePacer = new FramePacer();
+	m_framePacer->init(m_settings.framePacing, m_settings.targetFps, m_settings.useOpenGL && !m_settings.headless,
+		m_settings.headless ? nullptr : static_cast<SDL_Renderer*>(Renderer::Instance().getRenderer()));
 
 	// Initialize input
 	m_input.init();
 
+	JobSystem::Instance().init(m_settings.workerThreads);
+
+	// A replay only reproduces the run with the recorded seed and step length; the
+	// RNG is seeded before onInit so level setup draws the same numbers too
+	if (!m_settings.replayInputPath.empty())
+	{
+		m_input.startReplay(m_settings.replayInputPath.c_str());
+		if (m_input.getRecordedSimulationHz() != m_settings.simulationHz)
+		{
+			E2_LOG(Warning, "Input file was recorded at %d Hz, using that instead of %d Hz",
+				m_input.getRecordedSimulationHz(), m_settings.simulationHz);
+			m_settings.simulationHz = m_input.getRecordedSimulationHz();
+		}
+		srand(m_input.getRandomSeed());
+	}
+	else if (!m_settings.recordInputPath.empty())
+	{
+		uint32_t seed = static_cast<uint32_t>(time(nullptr));
+		m_input.startRecording(m_settings.recordInputPath.c_str(), seed, m_settings.simulationHz);
+		srand(seed);
+	}
+
+	if (!m_settings.statsPath.empty())
+	{
+		m_statsFile = fopen(m_settings.statsPath.c_str(), "w");
+		if (m_statsFile)
+		{
+			fprintf(m_statsFile, "frame,frame_ms,steps,physics_ms,pairs_ms,collide_ms,solve_ms,"
+				"bodies,shapes,contacts,islands,tasks,events,draw_calls\n");
+		}
+		else
+		{
+			E2_LOG(Warning, "Could not open stats file %s", m_settings.statsPath.c_str());
+		}
+	}
+
+	// Component storage mode has to be fixed before any GameObject exists
+	ComponentPools::Instance().setEnabled(m_settings.pooledComponents);
+
+	if (m_settings.simulationHz <= 0 || m_settings.maxStepsPerFrame <= 0)
+	{
+		throw EngineError("Invalid fixed timestep settings");
+	}
+	m_deltaTime = 1.0f / m_settings.simulationHz;
+
 	m_isRunning = true;
-	m_prevTime = SDL_GetTicks();
 
 	// To initialize game content
 	onInit();
@@ -46,38 +188,114 @@ void GameEngine::init()
 
 void GameEngine::run()
 {
-	m_prevTime = SDL_GetTicks();
+	const double counterFrequency = static_cast<double>(Platform::getCounterFrequency());
+	const float fixedStep = m_deltaTime;
+	m_accumulator = 0.0f;
+	m_prevCounter = Platform::getCounter();
+	m_framePacer->resetTiming();
+	m_frameCount = 0;
+	const uint64_t runStart = m_prevCounter;
 
-	while (m_isRunning)
+	if (m_settings.traceFrames > 0)
 	{
-		uint32_t currentTime = SDL_GetTicks();
-		m_deltaTime = (currentTime - m_prevTime) / 1000.0f;
-		m_prevTime = currentTime;
+		Profiler::Instance().beginCapture(m_settings.traceFrames, m_settings.tracePath.c_str());
+	}
 
-		SDL_Event event;
-		while (SDL_PollEvent(&event))
+	while (m_isRunning)
+	{
+		// The frame zone closes before the profiler's frame count advances
 		{
-			if (event.type == SDL_QUIT)
+			E2_PROFILE_SCOPE("Frame");
+
+			uint64_t currentCounter = Platform::getCounter();
+			m_frameTime = static_cast<float>((currentCounter - m_prevCounter) / counterFrequency);
+			m_prevCounter = currentCounter;
+
+			if (m_settings.headless)
 			{
-				m_isRunning = false;
+				// Nobody is watching: one step per frame, as fast as the simulation goes
+				m_accumulator += fixedStep;
+			}
+			else
+			{
+				// A stall must not turn into a burst of catch-up steps
+				m_accumulator += std::min(m_frameTime, m_settings.maxFrameTime);
 			}
-		}
-			
-		m_input.update();
 
-		// Update current level if it exists
-		if (m_currentLevel)
-		{
-			m_currentLevel->update(m_deltaTime);
-			m_currentLevel->render();
+			{
+				E2_PROFILE_SCOPE("Input");
+
+				m_input.update();
+				if (m_input.isQuitRequested())
+				{
+					m_isRunning = false;
+				}
+			}
+
+			// GL uploads and other work jobs handed back to this thread
+			JobSystem::Instance().processMainThreadJobs();
+
+			// Update current level if it exists
+			int steps = 0;
+			if (m_currentLevel)
+			{
+				while (m_accumulator >= fixedStep && steps < m_settings.maxStepsPerFrame)
+				{
+					// Input is latched per step, so a recording replays step for step
+					m_input.step();
+					if (m_input.isReplayFinished())
+					{
+						E2_LOG(Log, "Input replay finished");
+						m_isRunning = false;
+						break;
+					}
+
+					m_currentLevel->update(fixedStep);
+					m_accumulator -= fixedStep;
+					steps++;
+				}
+
+				// Still behind after the step budget: drop the backlog rather than spiral
+				if (m_accumulator >= fixedStep)
+				{
+					m_accumulator = 0.0f;
+				}
+
+				m_interpolationAlpha = m_accumulator / fixedStep;
+				m_currentLevel->render(m_interpolationAlpha);
+			}
+			else
+			{
+				// Default rendering if no level is set
+				m_accumulator = 0.0f;
+				Renderer::Instance().clear();
+				Renderer::Instance().present();
+			}
+
+			// Vsync already blocked in present; FixedFPS waits here
+			{
+				E2_PROFILE_SCOPE("FramePacer::endFrame");
+				m_framePacer->endFrame();
+			}
+
+			if (m_statsFile)
+			{
+				writeFrameStats(steps);
+			}
 		}
-		else
+
+		Profiler::Instance().endFrame();
+
+		m_frameCount++;
+		if (m_settings.maxFrames > 0 && m_frameCount >= m_settings.maxFrames)
 		{
-			// Default rendering if no level is set
-			Renderer::Instance().clear();
-			Renderer::Instance().present();
+			m_isRunning = false;
 		}
 	}
+
+	double seconds = (Platform::getCounter() - runStart) / counterFrequency;
+	E2_LOG(Log, "Ran %d frames in %.2f s (%.1f fps)%s", m_frameCount, seconds,
+		seconds > 0.0 ? m_frameCount / seconds : 0.0, m_settings.headless ? ", headless" : "");
 }
 
 void GameEngine::shutdown()
@@ -89,6 +307,28 @@ void GameEngine::shutdown()
 		delete m_currentLevel;
 		m_currentLevel = nullptr;
 	}
+
+	// Writes the input recording, if one was made
+	m_input.cleanup();
+
+	if (m_statsFile)
+	{
+		fclose(m_statsFile);
+		m_statsFile = nullptr;
+	}
+
+	JobSystem::Instance().logStats();
+	JobSystem::Instance().shutdown();
+
+	// Every texture should have been released with the level
+	TextureCache::Instance().logStats();
+	if (m_framePacer)
+	{
+		m_framePacer->logStats();
+		delete m_framePacer;
+		m_framePacer = nullptr;
+	}
+	TextureAtlas::Instance().clear();
 	
 	Renderer::Instance().cleanup();
 	
@@ -106,6 +346,36 @@ void* GameEngine::getRenderer()
 	return Renderer::Instance().getRenderer();
 }
 
+RenderStats GameEngine::getRenderStats() const
+{
+	return Renderer::Instance().getStats();
+}
+
+void GameEngine::setFramePacing(FramePacingMode mode, int targetFps)
+{
+	m_settings.framePacing = mode;
+	m_settings.targetFps = targetFps;
+	if (m_framePacer)
+	{
+		m_framePacer->setMode(mode, targetFps);
+	}
+}
+
+FramePacingMode GameEngine::getFramePacing() const
+{
+	return m_settings.framePacing;
+}
+
+FrameTimeStats GameEngine::getFrameTimeStats() const
+{
+	return m_framePacer ? m_framePacer->getStats() : FrameTimeStats();
+}
+
+TextureCacheStats GameEngine::getTextureCacheStats() const
+{
+	return TextureCache::Instance().getStats();
+}
+
 void GameEngine::setCurrentLevel(Level* Level)
 {
 	if (m_currentLevel)
@@ -113,4 +383,37 @@ void GameEngine::setCurrentLevel(Level* Level)
 		delete m_currentLevel;
 	}
 	m_currentLevel = Level;
+	if (m_currentLevel && m_settings.physicsOverlay)
+	{
+		m_currentLevel->setPhysicsOverlay(true);
+	}
+}
+
+void GameEngine::writeFrameStats(int steps)
+{
+	// Profile times add up over the frame's steps; counters are the last step's
+	PhysicsStepSample total;
+	PhysicsStepSample last;
+	PhysicsWorld* world = m_currentLevel ? m_currentLevel->getPhysicsWorld() : nullptr;
+	if (world)
+	{
+		for (int age = 0; age < std::min(steps, world->getStatsSampleCount()); age++)
+		{
+			const PhysicsStepSample& sample = world->getStatsSample(age);
+			total.stepMs += sample.stepMs;
+			total.pairsMs += sample.pairsMs;
+			total.collideMs += sample.collideMs;
+			total.solveMs += sample.solveMs;
+			total.events += sample.events;
+		}
+		if (steps > 0)
+		{
+			last = world->getStatsSample(0);
+		}
+	}
+
+	fprintf(m_statsFile, "%d,%.3f,%d,%.3f,%.3f,%.3f,%.3f,%d,%d,%d,%d,%d,%d,%d\n",
+		m_frameCount, m_frameTime * 1000.0f, steps, total.stepMs, total.pairsMs, total.collideMs, total.solveMs,
+		last.bodies, last.shapes, last.contacts, last.islands, last.tasks, total.events,
+		Renderer::Instance().getStats().drawCalls);
 }
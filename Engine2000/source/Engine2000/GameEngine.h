@@ -2,6 +2,11 @@
 
 #include "Core.h"
 #include "Input.h"
+#include "Renderer.h"
+#include "TextureCache.h"
+#include "FramePacer.h"
+#include "PhysicsBackend.h"
+#include <cstdio>
 #include <string>
 
 struct SDL_Renderer;
@@ -19,18 +24,46 @@ protected:
 		int width;
 		int height;
 		bool useOpenGL;
+		bool pooledComponents;	// Store Transform/Sprite/Physics in contiguous pools (see ComponentPools)
+		int simulationHz;		// Fixed simulation steps per second
+		int maxStepsPerFrame;	// Catch-up limit; the rest of a long frame is dropped
+		float maxFrameTime;		// Longer frames (breakpoints, window drags) are clamped to this, in seconds
+		FramePacingMode framePacing;
+		int targetFps;			// Used by FramePacingMode::FixedFPS
+		bool headless;			// No window or GPU; the null renderer counts draws, one step per frame, unpaced
+		int maxFrames;			// Stop after this many frames; 0 runs until quit
+		int traceFrames;		// Profile this many frames from the start of run(); 0 is off
+		std::string tracePath;	// Chrome trace JSON written when the capture ends
+		std::string recordInputPath;	// Record every step's input and the RNG seed to this file
+		std::string replayInputPath;	// Replay a recording instead of live input; the run ends with it
+		int workerThreads;		// Job system workers; -1 is one per core besides the main thread
+		PhysicsBackend physicsBackend;	// For the game to pass to its levels; --physics box2d|arcade
+		std::string statsPath;	// CSV row per frame: frame time, physics profile and counters, draws
+		bool physicsOverlay;	// Physics step graph on every level set; --physics-overlay
 		Settings(const std::string& t = "Engine 2000", int w = 640, int h = 480, bool gl = true)
-			: title(t), width(w), height(h), useOpenGL(gl) {}
+			: title(t), width(w), height(h), useOpenGL(gl), pooledComponents(false)
+			, simulationHz(60), maxStepsPerFrame(5), maxFrameTime(0.25f)
+			, framePacing(FramePacingMode::VSync), targetFps(60)
+			, headless(false), maxFrames(0), traceFrames(0), tracePath("trace.json")
+			, workerThreads(-1), physicsBackend(PhysicsBackend::Box2D), physicsOverlay(false) {}
 	};
 
 private:
 	Settings m_settings;
 	bool m_isRunning;
 	Window* m_window;
+	FramePacer* m_framePacer;
 	Level* m_currentLevel;
-	float m_deltaTime;
-	uint32_t m_prevTime;
+	float m_deltaTime;			// Fixed step handed to Level::update
+	float m_frameTime;			// Real time of the last frame
+	float m_accumulator;		// Simulation time owed, in seconds
+	float m_interpolationAlpha;
+	uint64_t m_prevCounter;
+	int m_frameCount;
 	Input m_input;
+	FILE* m_statsFile;
+
+	void writeFrameStats(int steps);
 
 public:
 	GameEngine(const Settings& settings = Settings());
@@ -38,6 +71,11 @@ public:
 
 	virtual void onInit() {}
 
+	// Command line overrides, before init(): --headless, --frames N, --trace N [file],
+	// --record file, --replay file, --threads N, --physics box2d|arcade, --stats-file file,
+	// --physics-overlay
+	void parseArguments(int argc, char** argv);
+
 	void init();
 	void run();
 	void shutdown();
@@ -48,11 +86,29 @@ public:
 	Level* getCurrentLevel() const { return m_currentLevel; }
 
 	float getDeltaTime() const { return m_deltaTime; }
+	float getFrameTime() const { return m_frameTime; }
+	float getInterpolationAlpha() const { return m_interpolationAlpha; }
+	int getFrameCount() const { return m_frameCount; }
+	bool isHeadless() const { return m_settings.headless; }
 
 	const Input& getInput() const { return m_input; }
 
 	int getWindowWidth() const { return m_settings.width; }
 	int getWindowHeight() const { return m_settings.height; }
+	PhysicsBackend getPhysicsBackend() const { return m_settings.physicsBackend; }
+
+	// Draw call / vertex counters from the last presented frame
+	RenderStats getRenderStats() const;
+
+	// Frame pacing; the mode can be switched at runtime
+	void setFramePacing(FramePacingMode mode, int targetFps = 60);
+	FramePacingMode getFramePacing() const;
+
+	// Mean, p99 and jitter of recent frame times, in milliseconds
+	FrameTimeStats getFrameTimeStats() const;
+
+	// Texture cache hit/miss and memory counters
+	TextureCacheStats getTextureCacheStats() const;
 };
 
 // To be defined in client
@@ -4,6 +4,16 @@
 
 GameObject::GameObject()
 	: m_transform(nullptr)
+	, m_componentMask(0)
+	, m_pooledMask(0)
+	, m_levelLayer(-1)
+	, m_levelSlot(0)
+	, m_pendingRemoval(false)
+	, m_poolType(nullptr)
+	, m_dormant(false)
+	, m_dormantSlot(0)
+	, m_dormantTime(0.0f)
+	, m_level(nullptr)
 {
 	// Create default transform component
 	m_transform = addComponent<TransformComponent>();
@@ -13,12 +23,36 @@ GameObject::~GameObject()
 {
 	for (auto component : m_components)
 	{
-		delete component;
+		if (isPooled(component))
+		{
+			ComponentPools::Instance().destroy(component);
+		}
+		else
+		{
+			delete component;
+		}
 	}
 	m_components.clear();
+	m_componentsByType.clear();
+	m_componentMask = 0;
 	m_transform = nullptr;
 }
 
+void GameObject::registerComponent(Component* component, ComponentTypeId typeId, bool pooled)
+{
+	uint64_t bit = 1ull << typeId;
+	size_t slot = countBits(m_componentMask & (bit - 1));
+
+	component->m_typeId = typeId;
+	m_components.push_back(component);
+	m_componentsByType.insert(m_componentsByType.begin() + slot, component);
+	m_componentMask |= bit;
+	if (pooled)
+	{
+		m_pooledMask |= bit;
+	}
+}
+
 void GameObject::setPosition(const Vector2D& pos)
 {
 	getTransform()->setPosition(pos);
@@ -34,9 +68,11 @@ void GameObject::init()
 
 void GameObject::update(float deltaTime)
 {
-	// Update components
+	// Update components; pooled ones are advanced by the level's system pass
 	for (auto& component : m_components) {
-		component->update(deltaTime);
+		if (!isPooled(component)) {
+			component->update(deltaTime);
+		}
 	}
 }
 
@@ -2,8 +2,13 @@
 
 #include "Core.h"
 #include "Component.h"
+#include "ComponentType.h"
+#include "ComponentPools.h"
+#include "GameObjectHandle.h"
 #include "TransformComponent.h"
+#include "Dormancy.h"
 #include "E2Log.h"
+#include <cstdint>
 #include <vector>
 #include <typeinfo>
 
@@ -15,7 +20,30 @@ class Level;
 class ENGINE2000_API GameObject {
 private:
 	TransformComponent* m_transform;
-	std::vector<Component*> m_components;
+	std::vector<Component*> m_components;		// Insertion order, drives init/update/render
+
+	// One bit per component type present; m_componentsByType is sorted by type id,
+	// so a type's slot is the number of set bits below its own
+	uint64_t m_componentMask;
+	std::vector<Component*> m_componentsByType;
+
+	// Components owned by ComponentPools; updated by Level's system pass, not by update()
+	uint64_t m_pooledMask;
+
+	void registerComponent(Component* component, ComponentTypeId typeId, bool pooled);
+
+	// Bookkeeping owned by Level: where the object sits in its layer, so removal is O(1)
+	int m_levelLayer;
+	size_t m_levelSlot;
+	bool m_pendingRemoval;
+	GameObjectHandle m_handle;
+	const std::type_info* m_poolType;	// Set for objects made by Level::acquireGameObject
+	bool m_dormant;
+	size_t m_dormantSlot;				// Index in Level's dormant list
+	float m_dormantTime;
+	DormancyTrigger m_wakeTrigger;
+
+	friend class Level;
 
 protected:
 	Level* m_level;
@@ -35,32 +63,74 @@ public:
 	Level* getLevel();
 	TransformComponent* getTransform() { return m_transform; }
 
+	// True once removeGameObject has been called; the object is deleted at the next processLists
+	bool isPendingRemoval() const { return m_pendingRemoval; }
+
+	// Issued by the level; safe to keep across frames, resolve it with Level::resolve
+	GameObjectHandle getHandle() const { return m_handle; }
+
+	// Pooled objects only (Level::acquireGameObject): onRelease runs when the object is
+	// parked, onAcquire when it is handed out again. Put it back in its just-constructed state.
+	bool isPooledObject() const { return m_poolType != nullptr; }
+	virtual void onAcquire() {}
+	virtual void onRelease() {}
+
+	// Dormant objects are out of the simulation, update and render (Level::makeDormant).
+	// onWake gets how long the object slept, for time-driven logic to catch up.
+	bool isDormant() const { return m_dormant; }
+	virtual void onWake(float dormantSeconds) {}
+
 	template<typename T> T* addComponent()
 	{
 		static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
 
 		// Check if component of this type already exists
-		if (getComponent<T>() != nullptr)
+		if (hasComponent<T>())
 		{
 			E2_LOG(Error, "Failed to add component: GameObject already has a %s", typeid(T).name());
 			return nullptr;
 		}
 
-		auto component = new T(this);
-		T* componentPtr = component;
-		m_components.push_back(component);
-		return componentPtr;
+		ComponentTypeId typeId = getComponentTypeId<T>();
+
+		// Pooled types are constructed inside the engine's pools when that mode is on
+		Component* pooled = ComponentPools::Instance().create(typeId, this);
+		T* component = pooled ? static_cast<T*>(pooled) : new T(this);
+		registerComponent(component, typeId, pooled != nullptr);
+		return component;
 	}
 
+	// Exact type lookup: a component is found under the type it was added as
 	template<typename T> T* getComponent()
 	{
 		static_assert(std::is_base_of<Component, T>::value, "T must inherit from Component");
-		for (auto component : m_components)
-		{
-			if (T* castComponent = dynamic_cast<T*>(component))
-				return castComponent;
-		}
-		return nullptr;
+		return static_cast<T*>(getComponent(getComponentTypeId<T>()));
+	}
+
+	template<typename T> bool hasComponent() const
+	{
+		return hasComponent(getComponentTypeId<T>());
+	}
+
+	// INVALID_COMPONENT_TYPE is one past the mask, so ids are checked before shifting
+	bool hasComponent(ComponentTypeId typeId) const
+	{
+		return typeId < MAX_COMPONENT_TYPES && ((m_componentMask >> typeId) & 1ull);
+	}
+
+	Component* getComponent(ComponentTypeId typeId)
+	{
+		if (typeId >= MAX_COMPONENT_TYPES) return nullptr;
+		uint64_t bit = 1ull << typeId;
+		if (!(m_componentMask & bit)) return nullptr;
+		return m_componentsByType[countBits(m_componentMask & (bit - 1))];
+	}
+
+	uint64_t getComponentMask() const { return m_componentMask; }
+	bool isPooled(const Component* component) const
+	{
+		ComponentTypeId typeId = component->getTypeId();
+		return typeId < MAX_COMPONENT_TYPES && ((m_pooledMask >> typeId) & 1ull);
 	}
 
 };
\ No newline at end of file
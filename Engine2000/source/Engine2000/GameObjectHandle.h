@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+
+// Weak reference to a GameObject owned by a Level: a slot index plus the
+// generation the slot had when the handle was issued. Once the object is
+// deleted the slot's generation moves on and the handle stops resolving.
+struct GameObjectHandle
+{
+	static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+	uint32_t index = INVALID_INDEX;
+	uint32_t generation = 0;
+
+	bool isNull() const { return index == INVALID_INDEX; }
+	void reset() { index = INVALID_INDEX; generation = 0; }
+
+	bool operator==(const GameObjectHandle& other) const { return index == other.index && generation == other.generation; }
+	bool operator!=(const GameObjectHandle& other) const { return !(*this == other); }
+};
@@ -7,7 +7,6 @@
 
 #include <SDL2/SDL.h>
 #include <glad/glad.h>
-#include <gl/GL.h>
 
 HealthBarComponent::HealthBarComponent(GameObject* owner)
 	: Component(owner)
@@ -44,7 +43,7 @@ void HealthBarComponent::render()
 	if (!level) return;
 
 	// Get transform position
-	auto pos = m_owner->getTransform()->getPosition();
+	auto pos = m_owner->getTransform()->getInterpolatedPosition(Renderer::Instance().getInterpolationAlpha());
 
 	// Calculate health percentage
 	float healthPercentage = m_currentHealth / m_maxHealth;
@@ -64,7 +63,7 @@ void HealthBarComponent::render()
 		m_height - 4
 	);
 
-	if (Renderer::Instance().isOpenGL()) {
+	if (Renderer::Instance().getBackend() != RenderBackend::SDL) {
 		Vector4D borderColor(0, 0, 0, 255);    // Black
 		Vector4D fillColor(0, 255, 0, 255);    // Green
 
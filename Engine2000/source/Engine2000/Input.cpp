@@ -1,16 +1,63 @@
 #include "Input.h"
+#include "EngineError.h"
 #include <SDL2/SDL.h>
+#include <cstdio>
+#include <cstring>
 #include <string>
-#include <iostream>
-#include <unordered_map>
+#include <vector>
 #include "E2Log.h"
 
+static const int KEY_COUNT = static_cast<int>(KeyCode::NUM0) + 1;
+static const int BUTTON_COUNT = static_cast<int>(Button::RightBumper) + 1;
+
+// Input file: header, then runs of identical steps
+static const char INPUT_FILE_MAGIC[4] = { 'E', '2', 'I', 'R' };
+static const uint32_t INPUT_FILE_VERSION = 1;
+
+struct InputFileHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t randomSeed;
+	uint32_t simulationHz;
+	uint32_t stepCount;
+	uint32_t runCount;
+};
+
+// One bit per KeyCode / Button
+struct InputState
+{
+	uint64_t keys = 0;
+	uint32_t buttons = 0;
+
+	bool operator==(const InputState& other) const { return keys == other.keys && buttons == other.buttons; }
+};
+
+struct InputRun
+{
+	uint32_t steps;
+	uint32_t buttons;
+	uint64_t keys;
+};
+
 class Input::InputImpl {
 private:
 	const Uint8* m_keyboardState;
 	SDL_GameController* m_gameController;
-	std::unordered_map<SDL_Scancode, bool> m_keyPressed;
-	std::unordered_map<SDL_Scancode, bool> m_keyReleased;
+	InputState m_current;
+	InputState m_previous;
+	InputMode m_mode;
+	bool m_quitRequested;
+
+	// Recording / replay
+	std::string m_filePath;
+	uint32_t m_randomSeed;
+	int m_simulationHz;
+	uint32_t m_stepCount;
+	std::vector<InputRun> m_runs;
+	size_t m_replayRun;
+	uint32_t m_replayStepInRun;
+	bool m_replayFinished;
 
 	SDL_Scancode getSDLScancode(KeyCode key) const
 	{
@@ -86,7 +133,10 @@ private:
 	}
 
 public:
-	InputImpl() : m_keyboardState(nullptr), m_gameController(nullptr) {}
+	InputImpl()
+		: m_keyboardState(nullptr), m_gameController(nullptr), m_mode(InputMode::Live), m_quitRequested(false)
+		, m_randomSeed(0), m_simulationHz(0), m_stepCount(0), m_replayRun(0), m_replayStepInRun(0)
+		, m_replayFinished(false) {}
 
 	void init()
 	{
@@ -100,52 +150,188 @@ public:
 		}
 	}
 
-	void clearFrameStates()
+	void handleEvent(const SDL_Event& event)
 	{
-		m_keyPressed.clear();
-		m_keyReleased.clear();
+		if (event.type == SDL_QUIT)
+		{
+			m_quitRequested = true;
+		}
 	}
 
-	void handleEvent(const SDL_Event& event)
+	InputState sampleDevices() const
 	{
-		if (event.type == SDL_KEYDOWN)
+		InputState state;
+		for (int i = 0; i < KEY_COUNT; i++)
 		{
-			if (!event.key.repeat)	// Detect initial key press
+			if (m_keyboardState && m_keyboardState[getSDLScancode(static_cast<KeyCode>(i))])
 			{
-				m_keyPressed[event.key.keysym.scancode] = true;
+				state.keys |= 1ull << i;
 			}
 		}
-		else if (event.type == SDL_KEYUP)
+		if (m_gameController)
 		{
-			m_keyReleased[event.key.keysym.scancode] = true;
+			for (int i = 0; i < BUTTON_COUNT; i++)
+			{
+				if (SDL_GameControllerGetButton(m_gameController, getSDLButton(static_cast<Button>(i))))
+				{
+					state.buttons |= 1u << i;
+				}
+			}
 		}
+		return state;
 	}
 
-	bool getKeyPressed(KeyCode key)
+	void step()
 	{
-		SDL_Scancode scancode = getSDLScancode(key);
-		return m_keyPressed[scancode];
+		m_previous = m_current;
+
+		if (m_mode == InputMode::Replaying)
+		{
+			if (m_replayRun >= m_runs.size())
+			{
+				m_replayFinished = true;
+				m_current = InputState();
+				return;
+			}
+
+			const InputRun& run = m_runs[m_replayRun];
+			m_current.keys = run.keys;
+			m_current.buttons = run.buttons;
+			if (++m_replayStepInRun >= run.steps)
+			{
+				m_replayRun++;
+				m_replayStepInRun = 0;
+			}
+			m_stepCount++;
+			return;
+		}
+
+		m_current = sampleDevices();
+
+		if (m_mode == InputMode::Recording)
+		{
+			// Held keys repeat the same state for many steps, so runs stay few
+			InputRun* last = m_runs.empty() ? nullptr : &m_runs.back();
+			if (last && last->keys == m_current.keys && last->buttons == m_current.buttons && last->steps < UINT32_MAX)
+			{
+				last->steps++;
+			}
+			else
+			{
+				m_runs.push_back({ 1, m_current.buttons, m_current.keys });
+			}
+			m_stepCount++;
+		}
 	}
 
-	bool getKeyReleased(KeyCode key)
+	void startRecording(const char* filePath, uint32_t randomSeed, int simulationHz)
 	{
-		SDL_Scancode scancode = getSDLScancode(key);
-		return m_keyReleased[scancode];
+		m_mode = InputMode::Recording;
+		m_filePath = filePath;
+		m_randomSeed = randomSeed;
+		m_simulationHz = simulationHz;
+		m_stepCount = 0;
+		m_runs.clear();
+		E2_LOG(Log, "Recording input to %s (seed %u)", filePath, randomSeed);
+	}
+
+	void startReplay(const char* filePath)
+	{
+		FILE* file = fopen(filePath, "rb");
+		if (!file)
+		{
+			throw EngineError("Cannot open input file: " + std::string(filePath));
+		}
+
+		InputFileHeader header;
+		bool valid = fread(&header, sizeof(header), 1, file) == 1
+			&& memcmp(header.magic, INPUT_FILE_MAGIC, sizeof(INPUT_FILE_MAGIC)) == 0
+			&& header.version == INPUT_FILE_VERSION;
+		if (valid)
+		{
+			m_runs.resize(header.runCount);
+			valid = header.runCount == 0 || fread(m_runs.data(), sizeof(InputRun), header.runCount, file) == header.runCount;
+		}
+		fclose(file);
+
+		if (!valid)
+		{
+			m_runs.clear();
+			throw EngineError("Invalid input file: " + std::string(filePath));
+		}
+
+		m_mode = InputMode::Replaying;
+		m_filePath = filePath;
+		m_randomSeed = header.randomSeed;
+		m_simulationHz = static_cast<int>(header.simulationHz);
+		m_stepCount = 0;
+		m_replayRun = 0;
+		m_replayStepInRun = 0;
+		m_replayFinished = false;
+		E2_LOG(Log, "Replaying %u steps of input from %s (seed %u)", header.stepCount, filePath, header.randomSeed);
+	}
+
+	void writeRecording()
+	{
+		if (m_mode != InputMode::Recording) return;
+
+		InputFileHeader header;
+		memcpy(header.magic, INPUT_FILE_MAGIC, sizeof(INPUT_FILE_MAGIC));
+		header.version = INPUT_FILE_VERSION;
+		header.randomSeed = m_randomSeed;
+		header.simulationHz = static_cast<uint32_t>(m_simulationHz);
+		header.stepCount = m_stepCount;
+		header.runCount = static_cast<uint32_t>(m_runs.size());
+
+		FILE* file = fopen(m_filePath.c_str(), "wb");
+		bool written = file
+			&& fwrite(&header, sizeof(header), 1, file) == 1
+			&& (m_runs.empty() || fwrite(m_runs.data(), sizeof(InputRun), m_runs.size(), file) == m_runs.size());
+		if (file) fclose(file);
+
+		if (written)
+		{
+			E2_LOG(Log, "Recorded %u steps of input to %s (%zu runs)", m_stepCount, m_filePath.c_str(), m_runs.size());
+		}
+		else
+		{
+			E2_LOG(Error, "Failed to write input file: %s", m_filePath.c_str());
+		}
+		m_mode = InputMode::Live;
+	}
+
+	bool getKeyPressed(KeyCode key) const
+	{
+		uint64_t bit = 1ull << static_cast<int>(key);
+		return (m_current.keys & bit) && !(m_previous.keys & bit);
+	}
+
+	bool getKeyReleased(KeyCode key) const
+	{
+		uint64_t bit = 1ull << static_cast<int>(key);
+		return !(m_current.keys & bit) && (m_previous.keys & bit);
 	}
 
 	bool getKey(KeyCode key) const
 	{
-		return m_keyboardState[getSDLScancode(key)];
+		return (m_current.keys >> static_cast<int>(key)) & 1;
 	}
 
 	bool getButton(Button button) const
 	{
-		if (!m_gameController) return false;
-		return SDL_GameControllerGetButton(m_gameController, getSDLButton(button));
+		return (m_current.buttons >> static_cast<int>(button)) & 1;
 	}
 
+	InputMode getMode() const { return m_mode; }
+	uint32_t getRandomSeed() const { return m_randomSeed; }
+	int getSimulationHz() const { return m_simulationHz; }
+	bool isReplayFinished() const { return m_replayFinished; }
+	bool isQuitRequested() const { return m_quitRequested; }
+
 	void cleanup()
 	{
+		writeRecording();
+
 		if (m_gameController)
 		{
 			SDL_GameControllerClose(m_gameController);
@@ -166,8 +352,11 @@ void Input::update()
 	while (SDL_PollEvent(&event)) {
 		pimpl->handleEvent(event);
 	}
-	// Clear the states for the next frame after all input processing is done
-	pimpl->clearFrameStates();
+}
+
+void Input::step()
+{
+	pimpl->step();
 }
 
 void Input::cleanup()
@@ -180,6 +369,41 @@ void Input::cleanup()
 	}
 }
 
+void Input::startRecording(const char* filePath, uint32_t randomSeed, int simulationHz)
+{
+	pimpl->startRecording(filePath, randomSeed, simulationHz);
+}
+
+void Input::startReplay(const char* filePath)
+{
+	pimpl->startReplay(filePath);
+}
+
+InputMode Input::getMode() const
+{
+	return pimpl ? pimpl->getMode() : InputMode::Live;
+}
+
+uint32_t Input::getRandomSeed() const
+{
+	return pimpl ? pimpl->getRandomSeed() : 0;
+}
+
+int Input::getRecordedSimulationHz() const
+{
+	return pimpl ? pimpl->getSimulationHz() : 0;
+}
+
+bool Input::isReplayFinished() const
+{
+	return pimpl ? pimpl->isReplayFinished() : false;
+}
+
+bool Input::isQuitRequested() const
+{
+	return pimpl ? pimpl->isQuitRequested() : false;
+}
+
 bool Input::getKey(KeyCode key) const
 {
 	return pimpl ? pimpl->getKey(key) : false;
@@ -198,4 +422,4 @@ bool Input::getKeyReleased(KeyCode key) const
 bool Input::getButton(Button button) const
 {
 	return pimpl ? pimpl->getButton(button) : false;
-}
\ No newline at end of file
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core.h"
+#include <cstdint>
 
 enum class KeyCode {
 	Left, Right, Up, Down,
@@ -18,6 +19,12 @@ enum class Button {
 	LeftStick, RightStick, LeftBumper, RightBumper
 };
 
+enum class InputMode {
+	Live,		// Keyboard and controller are read every step
+	Recording,	// Live, and every step's state is kept for the input file
+	Replaying	// States come from an input file instead of the devices
+};
+
 class ENGINE2000_API Input {
 private:
 	Input(const Input&) = delete;
@@ -27,13 +34,29 @@ private:
 	InputImpl* pimpl;
 
 public:
-	Input() = default;
+	Input() : pimpl(nullptr) {}
 	~Input() = default;
 
 	void init();
+	// Pumps SDL events, once per frame
 	void update();
+	// Latches the key/button state for one simulation step; edges compare against the previous step
+	void step();
+	// Writes the recording, if any
 	void cleanup();
 
+	// Recording keeps every step in memory and writes it on cleanup. The seed is only stored,
+	// the caller seeds the RNG with it
+	void startRecording(const char* filePath, uint32_t randomSeed, int simulationHz);
+	// Throws EngineError if the file cannot be read
+	void startReplay(const char* filePath);
+
+	InputMode getMode() const;
+	uint32_t getRandomSeed() const;		// Of the recording being made or replayed
+	int getRecordedSimulationHz() const;
+	bool isReplayFinished() const;		// step() ran past the last recorded state
+	bool isQuitRequested() const;		// Window closed
+
 	bool getKey(KeyCode key) const;
 	bool getKeyPressed(KeyCode Key) const;
 	bool getKeyReleased(KeyCode key) const;
@@ -0,0 +1,355 @@
+#include "JobSystem.h"
+#include "Platform.h"
+#include "Profiler.h"
+#include "E2Log.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	struct Job
+	{
+		std::function<void()> fn;
+		JobCounter* counter;
+	};
+
+	// The owner works at the back (most recently pushed, still warm in cache),
+	// thieves take from the front. A deque is only locked for the push or pop itself.
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+
+		std::atomic<uint64_t> busyTicks{ 0 };
+		std::atomic<uint64_t> executed{ 0 };
+		std::atomic<uint64_t> stolen{ 0 };
+	};
+
+	thread_local int t_threadIndex = 0;
+}
+
+class JobSystem::JobSystemImpl
+{
+public:
+	int workerCount = 0;
+	std::vector<std::unique_ptr<WorkerQueue>> queues;	// [0] is the main thread's
+	std::vector<std::thread> threads;
+	std::atomic<bool> running{ false };
+	std::atomic<int> queued{ 0 };
+
+	std::mutex sleepMutex;
+	std::condition_variable wake;
+
+	std::mutex mainThreadMutex;
+	std::vector<std::function<void()>> mainThreadJobs;
+
+	uint64_t statsStart = 0;
+
+	void push(int index, Job job)
+	{
+		{
+			std::lock_guard<std::mutex> lock(queues[index]->mutex);
+			queues[index]->jobs.push_back(std::move(job));
+		}
+		queued.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders this against a worker that is about to sleep
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+		}
+		wake.notify_one();
+	}
+
+	bool popOwn(int index, Job& job)
+	{
+		WorkerQueue& queue = *queues[index];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.jobs.empty()) return false;
+
+		job = std::move(queue.jobs.back());
+		queue.jobs.pop_back();
+		queued.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+
+	bool steal(int index, Job& job)
+	{
+		const int count = static_cast<int>(queues.size());
+		for (int i = 1; i < count; i++)
+		{
+			WorkerQueue& victim = *queues[(index + i) % count];
+			std::lock_guard<std::mutex> lock(victim.mutex);
+			if (victim.jobs.empty()) continue;
+
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			queued.fetch_sub(1, std::memory_order_relaxed);
+			queues[index]->stolen.fetch_add(1, std::memory_order_relaxed);
+			return true;
+		}
+		return false;
+	}
+
+	void execute(int index, Job& job)
+	{
+		uint64_t start = Platform::getCounter();
+		{
+			E2_PROFILE_SCOPE("Job");
+			job.fn();
+		}
+		WorkerQueue& queue = *queues[index];
+		queue.busyTicks.fetch_add(Platform::getCounter() - start, std::memory_order_relaxed);
+		queue.executed.fetch_add(1, std::memory_order_relaxed);
+
+		if (job.counter)
+		{
+			job.counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+	}
+
+	bool tryRunOne(int index)
+	{
+		Job job;
+		if (popOwn(index, job) || steal(index, job))
+		{
+			execute(index, job);
+			return true;
+		}
+		return false;
+	}
+
+	void workerLoop(int index)
+	{
+		t_threadIndex = index;
+
+		while (running.load(std::memory_order_acquire))
+		{
+			if (!tryRunOne(index))
+			{
+				std::unique_lock<std::mutex> lock(sleepMutex);
+				wake.wait(lock, [this] {
+					return queued.load(std::memory_order_acquire) > 0 || !running.load(std::memory_order_acquire);
+				});
+			}
+		}
+	}
+
+	void start(int workers)
+	{
+		workerCount = workers;
+		queues.clear();
+		for (int i = 0; i <= workerCount; i++)
+		{
+			queues.push_back(std::make_unique<WorkerQueue>());
+		}
+
+		running = true;
+		statsStart = Platform::getCounter();
+		for (int i = 1; i <= workerCount; i++)
+		{
+			threads.emplace_back(&JobSystemImpl::workerLoop, this, i);
+		}
+	}
+
+	void stop()
+	{
+		if (!running) return;
+
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			running = false;
+		}
+		wake.notify_all();
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		threads.clear();
+
+		// Nothing may be left behind with a counter still waiting on it
+		while (tryRunOne(0)) {}
+		processMainThreadJobs();
+	}
+
+	void processMainThreadJobs()
+	{
+		std::vector<std::function<void()>> jobs;
+		{
+			std::lock_guard<std::mutex> lock(mainThreadMutex);
+			jobs.swap(mainThreadJobs);
+		}
+		for (auto& job : jobs)
+		{
+			job();
+		}
+	}
+};
+
+JobSystem::JobSystem()
+	: pimpl(new JobSystemImpl())
+{
+}
+
+JobSystem::~JobSystem()
+{
+	shutdown();
+	delete pimpl;
+}
+
+JobSystem& JobSystem::Instance()
+{
+	static JobSystem instance;
+	return instance;
+}
+
+void JobSystem::init(int workerCount)
+{
+	shutdown();
+
+	if (workerCount < 0)
+	{
+		int cores = static_cast<int>(std::thread::hardware_concurrency());
+		workerCount = std::max(0, cores - 1);
+	}
+
+	pimpl->start(workerCount);
+	E2_LOG(Log, "Job system: %d worker thread(s)", workerCount);
+}
+
+void JobSystem::shutdown()
+{
+	pimpl->stop();
+}
+
+int JobSystem::getWorkerCount() const
+{
+	return pimpl->workerCount;
+}
+
+int JobSystem::getCurrentThreadIndex() const
+{
+	return t_threadIndex;
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter* counter)
+{
+	if (!pimpl->running || pimpl->workerCount == 0)
+	{
+		job();
+		return;
+	}
+
+	if (counter)
+	{
+		counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+	}
+	pimpl->push(t_threadIndex, Job{ std::move(job), counter });
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+	while (!counter.isDone())
+	{
+		if (!pimpl->tryRunOne(t_threadIndex))
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::parallelFor(int count, int minBatch, const std::function<void(int, int)>& fn)
+{
+	if (count <= 0) return;
+	minBatch = std::max(1, minBatch);
+
+	// A few batches per thread so a slow batch does not leave the others idle
+	const int threads = pimpl->workerCount + 1;
+	const int batches = std::min((count + minBatch - 1) / minBatch, threads * 4);
+	if (!pimpl->running || pimpl->workerCount == 0 || batches <= 1)
+	{
+		fn(0, count);
+		return;
+	}
+
+	const int batchSize = (count + batches - 1) / batches;
+	JobCounter counter;
+	for (int begin = batchSize; begin < count; begin += batchSize)
+	{
+		int end = std::min(begin + batchSize, count);
+		submit([&fn, begin, end] { fn(begin, end); }, &counter);
+	}
+
+	// The first batch runs here, then this thread helps with the rest
+	fn(0, std::min(batchSize, count));
+	wait(counter);
+}
+
+void JobSystem::runOnMainThread(std::function<void()> job)
+{
+	std::lock_guard<std::mutex> lock(pimpl->mainThreadMutex);
+	pimpl->mainThreadJobs.push_back(std::move(job));
+}
+
+void JobSystem::processMainThreadJobs()
+{
+	pimpl->processMainThreadJobs();
+}
+
+JobSystemStats JobSystem::getStats() const
+{
+	JobSystemStats stats;
+	stats.workers = pimpl->workerCount;
+
+	uint64_t busy = 0;
+	for (size_t i = 0; i < pimpl->queues.size(); i++)
+	{
+		const WorkerQueue& queue = *pimpl->queues[i];
+		stats.jobsExecuted += queue.executed.load(std::memory_order_relaxed);
+		stats.jobsStolen += queue.stolen.load(std::memory_order_relaxed);
+		if (i > 0)
+		{
+			busy += queue.busyTicks.load(std::memory_order_relaxed);
+		}
+	}
+
+	uint64_t elapsed = Platform::getCounter() - pimpl->statsStart;
+	if (stats.workers > 0 && elapsed > 0)
+	{
+		stats.utilization = static_cast<float>(static_cast<double>(busy) / (static_cast<double>(elapsed) * stats.workers));
+	}
+	return stats;
+}
+
+void JobSystem::resetStats()
+{
+	for (auto& queue : pimpl->queues)
+	{
+		queue->busyTicks = 0;
+		queue->executed = 0;
+		queue->stolen = 0;
+	}
+	pimpl->statsStart = Platform::getCounter();
+}
+
+float JobSystem::getWorkerUtilization(int worker) const
+{
+	if (worker < 1 || worker > pimpl->workerCount) return 0.0f;
+
+	uint64_t elapsed = Platform::getCounter() - pimpl->statsStart;
+	if (elapsed == 0) return 0.0f;
+	return static_cast<float>(static_cast<double>(pimpl->queues[worker]->busyTicks.load(std::memory_order_relaxed)) / elapsed);
+}
+
+void JobSystem::logStats() const
+{
+	JobSystemStats stats = getStats();
+	E2_LOG(Log, "Jobs: %llu executed, %llu stolen, %d workers at %.1f%% utilization",
+		static_cast<unsigned long long>(stats.jobsExecuted), static_cast<unsigned long long>(stats.jobsStolen),
+		stats.workers, stats.utilization * 100.0f);
+}
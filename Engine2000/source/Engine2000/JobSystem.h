@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Core.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+// Counts the unfinished jobs submitted against it; wait() on it to join them.
+// A job can itself wait on another counter, which is how dependencies are expressed.
+class ENGINE2000_API JobCounter {
+private:
+	std::atomic<int> m_pending{ 0 };
+
+	friend class JobSystem;
+
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+};
+
+struct JobSystemStats
+{
+	int workers = 0;
+	uint64_t jobsExecuted = 0;
+	uint64_t jobsStolen = 0;	// Taken from another thread's deque
+	float utilization = 0.0f;	// Worker busy time over wall time since resetStats, 0..1
+};
+
+// Worker threads with one deque each. A thread pushes and pops at the back of its own
+// deque and idle threads steal from the front of others'. The main thread has a deque
+// too and runs jobs while it waits. Jobs must not touch OpenGL: queue that with
+// runOnMainThread, which GameEngine drains once per frame.
+class ENGINE2000_API JobSystem {
+private:
+	// Singleton pattern
+	JobSystem();
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	class JobSystemImpl;
+	JobSystemImpl* pimpl;
+
+public:
+	static JobSystem& Instance();
+
+	// workerCount < 0 uses one worker per core besides the main thread; 0 runs every job inline
+	void init(int workerCount = -1);
+	void shutdown();
+
+	int getWorkerCount() const;
+	// 0 on the main thread (and any thread the system did not start), 1..workers on workers
+	int getCurrentThreadIndex() const;
+
+	void submit(std::function<void()> job, JobCounter* counter = nullptr);
+	// Runs queued jobs on the calling thread until the counter reaches zero
+	void wait(JobCounter& counter);
+
+	// Calls fn(begin, end) over [0, count) in batches of at least minBatch and returns when all are done
+	void parallelFor(int count, int minBatch, const std::function<void(int, int)>& fn);
+
+	// For work that needs the GL context; runs at the start of the next frame
+	void runOnMainThread(std::function<void()> job);
+	void processMainThreadJobs();
+
+	JobSystemStats getStats() const;
+	void resetStats();
+	float getWorkerUtilization(int worker) const;	// worker in 1..getWorkerCount()
+	void logStats() const;
+};
@@ -3,24 +3,58 @@
 #include "GameObject.h"
 #include "Renderer.h"
 #include "PhysicsWorld.h"
+#include "PhysicsComponent.h"
+#include "ScreenBoundsComponent.h"
+#include "ComponentPools.h"
+#include "Profiler.h"
 #include <algorithm>
 #include <iostream>
 #include <SDL2/SDL.h>
 
-inline Level::Level(const Input& input, int screenWidth, int screenHeight)
+Level::Level(const Input& input, int screenWidth, int screenHeight, PhysicsBackend physicsBackend)
 	: m_input(input)
+#ifdef ENGINE2000_BUILD_DEBUG
+    , m_debugStaleHandles(true)
+#else
+    , m_debugStaleHandles(false)
+#endif
+    , m_staleHandleResolves(0)
 	, m_screenWidth(screenWidth)
 	, m_screenHeight(screenHeight)
 {
+    for (int i = 0; i < TOTAL_LAYERS; i++) {
+        m_layerHasHoles[i] = false;
+    }
+
+    m_physicsOverlay = false;
+
     // Initialize physics world with screen dimensions
     m_physicsWorld = new PhysicsWorld;
-    m_physicsWorld->init(screenWidth, screenHeight, Vector2D(0.0f, 0.0f));
+    m_physicsWorld->init(screenWidth, screenHeight, Vector2D(0.0f, 0.0f), 0, physicsBackend);
 }
 
 Level::~Level() {
-    // Clean up pending objects
+    // Objects still waiting to be added are owned by the level too;
+    // pending removals are already in a layer or in m_pendingAdds
+    for (const auto& pending : m_pendingAdds)
+    {
+        delete pending.obj;
+    }
     m_pendingAdds.clear();
     m_pendingRemoves.clear();
+
+    for (auto& pool : m_objectPools)
+    {
+        for (auto obj : pool.second)
+        {
+            delete obj;
+        }
+    }
+    m_objectPools.clear();
+
+    // Nothing may resolve while objects below are being destroyed
+    m_handleSlots.clear();
+    m_freeHandleSlots.clear();
     
     // Clean up all layers
     for (int i = 0; i < TOTAL_LAYERS; i++)
@@ -35,39 +69,102 @@ Level::~Level() {
         m_layers[i].clear();
     }
 
+    // Last, so components above could still hand their bodies back to it
+    delete m_physicsWorld;
+    m_physicsWorld = nullptr;
 }
 
 void Level::processLists() {
-    // Process removals
-    for (auto obj : m_pendingRemoves)
+    // Process additions first so an object created and removed in the same frame
+    // goes through the normal removal path
+    for (const auto& pending : m_pendingAdds)
     {
-        for (int i = 0; i < TOTAL_LAYERS; i++)
+        if (pending.obj)
         {
-            auto& layer = m_layers[i];
-            auto it = std::find(layer.begin(), layer.end(), obj);
-            if (it != layer.end())
+            auto& layer = m_layers[pending.layer];
+            pending.obj->m_levelLayer = pending.layer;
+            pending.obj->m_levelSlot = layer.size();
+            layer.push_back(pending.obj);
+
+            // Spawned (or reused from a pool) in place: nothing to blend from
+            pending.obj->getTransform()->storePreviousPosition();
+
+            if (auto bounds = pending.obj->getComponent<ScreenBoundsComponent>())
             {
-                layer.erase(it);
-                break;
+                m_physicsWorld->addBoundsVolume(bounds);
             }
         }
     }
+    m_pendingAdds.clear();
 
-    for (auto obj : m_pendingRemoves)
+    // Process removals: null the slot now, compact the layer once below.
+    // Indexed because onRelease may remove more objects (e.g. a text's characters)
+    for (size_t i = 0; i < m_pendingRemoves.size(); i++)
     {
-        delete obj;
+        GameObject* obj = m_pendingRemoves[i];
+        int layer = obj->m_levelLayer;
+        if (layer >= 0 && obj->m_levelSlot < m_layers[layer].size() && m_layers[layer][obj->m_levelSlot] == obj)
+        {
+            m_layers[layer][obj->m_levelSlot] = nullptr;
+            m_layerHasHoles[layer] = true;
+        }
+        obj->m_levelLayer = -1;
+        releaseHandle(obj);
+
+        if (auto bounds = obj->getComponent<ScreenBoundsComponent>())
+        {
+            m_physicsWorld->removeBoundsVolume(bounds);
+        }
+
+        // Leaves the dormant list; a pooled object comes back awake
+        if (obj->m_dormant)
+        {
+            removeDormant(obj);
+            if (auto physics = obj->getComponent<PhysicsComponent>())
+            {
+                physics->setDormant(false);
+            }
+        }
+
+        if (obj->m_poolType)
+        {
+            // Handle is already invalidated, so nothing can reach the object while it is parked
+            obj->onRelease();
+            setPooledComponentsActive(obj, false);
+            m_objectPools[std::type_index(*obj->m_poolType)].push_back(obj);
+        }
+        else
+        {
+            delete obj;
+        }
     }
     m_pendingRemoves.clear();
 
-    // Process additions
-    for (const auto& pending : m_pendingAdds)
+    for (int i = 0; i < TOTAL_LAYERS; i++)
     {
-        if (pending.obj)
+        if (m_layerHasHoles[i])
         {
-            m_layers[pending.layer].push_back(pending.obj);
+            compactLayer(i);
         }
     }
-    m_pendingAdds.clear();
+}
+
+void Level::compactLayer(int layer)
+{
+    // Stable so render order within the layer is preserved
+    auto& objects = m_layers[layer];
+    size_t write = 0;
+    for (size_t read = 0; read < objects.size(); read++)
+    {
+        GameObject* obj = objects[read];
+        if (obj)
+        {
+            obj->m_levelSlot = write;
+            objects[write++] = obj;
+        }
+    }
+    objects.resize(write);
+    m_layerHasHoles[layer] = false;
 }
 
 void Level::setGravity(const Vector2D& gravity)
@@ -77,61 +174,126 @@ void Level::setGravity(const Vector2D& gravity)
 	}
 }
 
+// Zone names per layer; the profiler keeps the pointers, so they are literals
+static const char* const LAYER_UPDATE_ZONES[Level::TOTAL_LAYERS] = {
+    "Level::update BACKGROUND", "Level::update GAME", "Level::update FOREGROUND",
+    "Level::update PLAYER", "Level::update UI"
+};
+static const char* const LAYER_RENDER_ZONES[Level::TOTAL_LAYERS] = {
+    "Level::render BACKGROUND", "Level::render GAME", "Level::render FOREGROUND",
+    "Level::render PLAYER", "Level::render UI"
+};
+
 void Level::update(float deltaTime)
 {
+    E2_PROFILE_SCOPE("Level::update");
+
+    // Snapshot where everything was before this step, for render interpolation
+    for (int i = 0; i < TOTAL_LAYERS; i++) {
+        for (auto obj : m_layers[i]) {
+            if (obj) obj->getTransform()->storePreviousPosition();
+        }
+    }
+
     if (m_physicsWorld) {
-        m_physicsWorld->update();
+        m_physicsWorld->update(deltaTime);
     }
 
+    // Wake triggers; woken objects take part in this step's update
+    updateDormant(deltaTime);
+
     // Process any pending additions/removals first
-    processLists();
+    {
+        E2_PROFILE_SCOPE("Level::processLists");
+        processLists();
+    }
 
-    // Update all objects
+    // Update all objects; adds and removals are deferred, so layers do not change here
     for (int i = 0; i < TOTAL_LAYERS; i++) {
-        auto& currentLayer = m_layers[i];
-        
-        // Remove null objects and update remaining ones
-        currentLayer.erase(
-            std::remove_if(currentLayer.begin(), currentLayer.end(),
-                [deltaTime](GameObject* obj) {
-                    if (obj == nullptr) return true;
-                    obj->update(deltaTime);
-                    return false;
-                }),
-            currentLayer.end()
-        );
-    }
-}
-
-void Level::render() {
+        E2_PROFILE_SCOPE(LAYER_UPDATE_ZONES[i]);
+        for (auto obj : m_layers[i]) {
+            if (obj && !obj->m_dormant) obj->update(deltaTime);
+        }
+    }
+
+    // Pooled components are advanced here in one linear pass per type
+    if (ComponentPools::Instance().isEnabled()) {
+        E2_PROFILE_SCOPE("ComponentPools::update");
+        ComponentPools::Instance().update(deltaTime);
+    }
+
+    // Screen bounds for everything at its final position for this step
+    if (m_physicsWorld) {
+        m_physicsWorld->updateBounds();
+    }
+}
+
+void Level::render(float alpha) {
+    E2_PROFILE_SCOPE("Level::render");
+
     Renderer::Instance().clear();
+    Renderer::Instance().setInterpolationAlpha(alpha);
 
     // Background color (works for both OpenGL and SDL2)
     Renderer::Instance().setDrawColor(64, 0, 64, 255);
 
-    // Render all layers in order
-    for (auto obj : m_layers[BACKGROUND]) {
-        if (obj) obj->render();
+    // Render all layers in order; the sprite batch keeps this order when it sorts
+    for (int layer = 0; layer < TOTAL_LAYERS; ++layer) {
+        E2_PROFILE_SCOPE(LAYER_RENDER_ZONES[layer]);
+        Renderer::Instance().setLayer(layer);
+        for (auto obj : m_layers[layer]) {
+            if (obj && !obj->m_dormant) obj->render();
+        }
     }
 
-    for (auto obj : m_layers[GAME]) {
-        if (obj) obj->render();
+    if (m_physicsOverlay) {
+        renderPhysicsOverlay();
     }
 
-    for (auto obj : m_layers[FOREGROUND]) {
-        if (obj) obj->render();
+    {
+        E2_PROFILE_SCOPE("Renderer::present");
+        Renderer::Instance().present();
     }
+}
 
-    // Add PLAYER layer rendering
-    for (auto obj : m_layers[PLAYER]) {
-        if (obj) obj->render();
-    }
+PhysicsStatsSummary Level::getPhysicsStats() const
+{
+    return m_physicsWorld->getStatsSummary();
+}
 
-    for (auto obj : m_layers[UI]) {
-        if (obj) obj->render();
+void Level::renderPhysicsOverlay()
+{
+    // One column per step, newest on the right: solve time in blue under the rest of the
+    // step in yellow, against a scale of OVERLAY_MS; the red line is the average step
+    static const float OVERLAY_MS = 8.0f;
+    static const float HEIGHT = 64.0f;
+    static const float MARGIN = 8.0f;
+
+    const int count = m_physicsWorld->getStatsSampleCount();
+    const float width = static_cast<float>(PhysicsWorld::STATS_HISTORY);
+    const float left = MARGIN;
+    const float bottom = m_screenHeight - MARGIN;
+    const float scale = HEIGHT / OVERLAY_MS;
+
+    Renderer& renderer = Renderer::Instance();
+    renderer.setLayer(UI);
+    renderer.fillRect(Vector4D(left, bottom - HEIGHT, width, HEIGHT), Vector4D(0, 0, 0, 160));
+
+    for (int age = 0; age < count; ++age) {
+        const PhysicsStepSample& sample = m_physicsWorld->getStatsSample(age);
+        float x = left + width - 1.0f - age;
+        float solve = std::min(sample.solveMs * scale, HEIGHT);
+        float step = std::min(sample.stepMs * scale, HEIGHT);
+        if (step > solve) {
+            renderer.fillRect(Vector4D(x, bottom - step, 1.0f, step - solve), Vector4D(255, 200, 0, 255));
+        }
+        if (solve > 0.0f) {
+            renderer.fillRect(Vector4D(x, bottom - solve, 1.0f, solve), Vector4D(0, 120, 255, 255));
+        }
     }
 
-    Renderer::Instance().present();
+    float average = std::min(getPhysicsStats().stepMs.avg * scale, HEIGHT);
+    renderer.fillRect(Vector4D(left, bottom - average, width, 1.0f), Vector4D(255, 0, 0, 255));
 }
 
 void* Level::getRenderer() const
@@ -142,6 +304,8 @@ void* Level::getRenderer() const
 void Level::addGameObject(GameObject* obj, Layer layer) {
     if (obj)
     {
+        assignHandle(obj);
+
         PendingObject pending;
         pending.obj = obj;
         pending.layer = layer;
@@ -151,8 +315,193 @@ void Level::addGameObject(GameObject* obj, Layer layer) {
 
 void Level::removeGameObject(GameObject* obj)
 {
-    if (obj)
+    // Idempotent: a second call for the same object is ignored
+    if (obj && !obj->m_pendingRemoval)
     {
+        obj->m_pendingRemoval = true;
         m_pendingRemoves.push_back(obj);
     }
-}
\ No newline at end of file
+}
+
+void Level::makeDormant(GameObject* obj, const DormancyTrigger& trigger)
+{
+    if (!obj || obj->m_pendingRemoval) return;
+
+    obj->m_wakeTrigger = trigger;
+    obj->m_dormantTime = 0.0f;
+    if (obj->m_dormant) return;
+
+    obj->m_dormant = true;
+    obj->m_dormantSlot = m_dormantObjects.size();
+    m_dormantObjects.push_back(obj);
+
+    if (auto physics = obj->getComponent<PhysicsComponent>()) {
+        physics->setDormant(true);
+    }
+}
+
+void Level::wakeObject(GameObject* obj)
+{
+    if (!obj || !obj->m_dormant) return;
+
+    removeDormant(obj);
+    if (auto physics = obj->getComponent<PhysicsComponent>()) {
+        physics->setDormant(false);
+    }
+
+    // It was not rendered while asleep, so there is nothing to blend from
+    obj->getTransform()->storePreviousPosition();
+    obj->onWake(obj->m_dormantTime);
+}
+
+void Level::removeDormant(GameObject* obj)
+{
+    // Swap with the last entry so removal is O(1)
+    GameObject* last = m_dormantObjects.back();
+    m_dormantObjects[obj->m_dormantSlot] = last;
+    last->m_dormantSlot = obj->m_dormantSlot;
+    m_dormantObjects.pop_back();
+    obj->m_dormant = false;
+}
+
+void Level::updateDormant(float deltaTime)
+{
+    if (m_dormantObjects.empty()) return;
+    E2_PROFILE_SCOPE("Level::updateDormant");
+
+    float physicsStep = m_physicsWorld ? m_physicsWorld->getTimeStep() : 0.0f;
+
+    // Waking swaps the last entry into slot i, which is then checked in its turn
+    for (size_t i = 0; i < m_dormantObjects.size();) {
+        GameObject* obj = m_dormantObjects[i];
+        const DormancyTrigger& trigger = obj->m_wakeTrigger;
+        obj->m_dormantTime += deltaTime;
+
+        if (trigger.drift) {
+            if (auto physics = obj->getComponent<PhysicsComponent>()) {
+                physics->advanceDormant(physicsStep);
+            }
+        }
+
+        bool wake = trigger.wakeAfter >= 0.0f && obj->m_dormantTime >= trigger.wakeAfter;
+        if (!wake && trigger.useRegion) {
+            Vector2D pos = obj->getTransform()->getPosition();
+            wake = pos.x >= trigger.region.x && pos.x <= trigger.region.getRight()
+                && pos.y >= trigger.region.y && pos.y <= trigger.region.getBottom();
+        }
+
+        if (wake) {
+            wakeObject(obj);
+        }
+        else {
+            i++;
+        }
+    }
+}
+
+int Level::getActiveObjectCount() const
+{
+    int count = 0;
+    for (int i = 0; i < TOTAL_LAYERS; i++) {
+        for (auto obj : m_layers[i]) {
+            if (obj && !obj->m_dormant) count++;
+        }
+    }
+    return count;
+}
+
+void Level::reuseGameObject(GameObject* obj, Layer layer)
+{
+    obj->m_pendingRemoval = false;
+    setPooledComponentsActive(obj, true);
+    obj->onAcquire();
+    addGameObject(obj, layer);
+}
+
+void Level::setPooledComponentsActive(GameObject* obj, bool active)
+{
+    // A parked object's pooled components stay out of ComponentPools::update
+    for (Component* component : obj->m_components)
+    {
+        if (obj->isPooled(component))
+        {
+            ComponentPools::Instance().setActive(component, active);
+        }
+    }
+}
+
+size_t Level::getPooledObjectCount() const
+{
+    size_t count = 0;
+    for (const auto& pool : m_objectPools)
+    {
+        count += pool.second.size();
+    }
+    return count;
+}
+
+void Level::assignHandle(GameObject* obj)
+{
+    // Objects made through createGameObject already have one
+    if (!obj->m_handle.isNull()) return;
+
+    uint32_t index;
+    if (!m_freeHandleSlots.empty())
+    {
+        index = m_freeHandleSlots.back();
+        m_freeHandleSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(m_handleSlots.size());
+        m_handleSlots.push_back({ nullptr, 0 });
+    }
+
+    m_handleSlots[index].obj = obj;
+    obj->m_handle.index = index;
+    obj->m_handle.generation = m_handleSlots[index].generation;
+}
+
+void Level::releaseHandle(GameObject* obj)
+{
+    GameObjectHandle handle = obj->m_handle;
+    if (handle.isNull() || handle.index >= m_handleSlots.size()) return;
+
+    HandleSlot& slot = m_handleSlots[handle.index];
+    if (slot.obj != obj) return;
+
+    // Bumping the generation invalidates every outstanding copy of the handle
+    slot.obj = nullptr;
+    slot.generation++;
+    m_freeHandleSlots.push_back(handle.index);
+    obj->m_handle.reset();
+}
+
+GameObject* Level::resolve(GameObjectHandle handle) const
+{
+    if (handle.isNull()) return nullptr;
+
+    if (handle.index < m_handleSlots.size())
+    {
+        const HandleSlot& slot = m_handleSlots[handle.index];
+        if (slot.generation == handle.generation && slot.obj)
+        {
+            return slot.obj;
+        }
+    }
+
+    m_staleHandleResolves++;
+    if (m_debugStaleHandles)
+    {
+        E2_LOG(Warning, "Stale GameObject handle resolved (index %u, generation %u)", handle.index, handle.generation);
+    }
+    return nullptr;
+}
+
+bool Level::isAlive(GameObjectHandle handle) const
+{
+    if (handle.isNull() || handle.index >= m_handleSlots.size()) return false;
+
+    const HandleSlot& slot = m_handleSlots[handle.index];
+    return slot.generation == handle.generation && slot.obj != nullptr;
+}
@@ -2,8 +2,14 @@
 
 #include "Core.h"
 #include "E2Log.h"
-#include "Vector2d.h"
+#include "Vector2D.h"
+#include "GameObjectHandle.h"
+#include "Dormancy.h"
+#include "PhysicsBackend.h"
 #include <vector>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 
 struct SDL_Renderer;
 
@@ -11,6 +17,7 @@ class GameEngine;
 class GameObject;
 class Input;
 class PhysicsWorld;
+struct PhysicsStatsSummary;
 
 class ENGINE2000_API Level {
 public:
@@ -33,17 +40,37 @@ protected:
     std::vector<GameObject*> m_layers[TOTAL_LAYERS];
     std::vector<PendingObject> m_pendingAdds;  // Change type from GameObject* to PendingObject
     std::vector<GameObject*> m_pendingRemoves;
+    bool m_layerHasHoles[TOTAL_LAYERS];        // Removed slots are nulled and compacted once per frame
+
+    // Handle table: slots are recycled through the free list, generations tell reuses apart
+    struct HandleSlot {
+        GameObject* obj;
+        uint32_t generation;
+    };
+    std::vector<HandleSlot> m_handleSlots;
+    std::vector<uint32_t> m_freeHandleSlots;
+    bool m_debugStaleHandles;
+    mutable int m_staleHandleResolves;
+
+    // Released pooled objects, keyed by concrete type; see acquireGameObject
+    std::unordered_map<std::type_index, std::vector<GameObject*>> m_objectPools;
+
+    // Dormant objects, checked for their wake triggers each step; see makeDormant
+    std::vector<GameObject*> m_dormantObjects;
 	int m_screenWidth;
 	int m_screenHeight;
     PhysicsWorld* m_physicsWorld;
+    bool m_physicsOverlay;
 
 public:
-    Level(const Input& input, int screenWidth, int screenHeight);
+    // The backend is fixed for the level's lifetime; Arcade suits games that only need overlaps
+    Level(const Input& input, int screenWidth, int screenHeight, PhysicsBackend physicsBackend = PhysicsBackend::Box2D);
     virtual ~Level();
 
 	template<typename T, typename... Args>
 	T* createGameObject(Args&&... args) {
 		T* obj = new T(std::forward<Args>(args)...);
+        assignHandle(obj);
         obj->setLevel(this);
 		addGameObject(obj);
 		return obj;
@@ -52,13 +79,38 @@ public:
 	template<typename T, typename... Args>
 	T* createGameObject(Layer layer, Args&&... args) {
 		T* obj = new T(std::forward<Args>(args)...);
+        assignHandle(obj);
         obj->setLevel(this);
 		addGameObject(obj, layer);
 		return obj;
 	}
 
+    // Like createGameObject, but removeGameObject hands the object back to a per-type pool
+    // instead of deleting it. Reused objects keep their components, textures and physics
+    // body; onRelease/onAcquire reset them. The constructor and init() run only once.
+    template<typename T>
+    T* acquireGameObject(Layer layer = GAME) {
+        static_assert(std::is_base_of<GameObject, T>::value, "T must inherit from GameObject");
+
+        auto& pool = m_objectPools[std::type_index(typeid(T))];
+        if (!pool.empty()) {
+            T* obj = static_cast<T*>(pool.back());
+            pool.pop_back();
+            reuseGameObject(obj, layer);
+            return obj;
+        }
+
+        T* obj = new T();
+        obj->m_poolType = &typeid(T);
+        assignHandle(obj);
+        obj->setLevel(this);
+        addGameObject(obj, layer);
+        return obj;
+    }
+
     virtual void update(float deltaTime);
-	void render();
+	// alpha blends each transform between the previous and current fixed step
+	void render(float alpha = 1.0f);
 
 	void* getRenderer() const;
 
@@ -69,10 +121,51 @@ public:
 
     void processLists(); // Process pending additions and removals
 
+    // Handles: O(1) lookups that return nullptr once the object has been deleted
+    GameObject* resolve(GameObjectHandle handle) const;
+    template<typename T>
+    T* resolve(GameObjectHandle handle) const {
+        // The caller vouches for the type, as it created the object behind the handle
+        return static_cast<T*>(resolve(handle));
+    }
+    bool isAlive(GameObjectHandle handle) const;
+
+    // Logs every resolve() of a handle whose object is gone
+    void setStaleHandleDebug(bool enable) { m_debugStaleHandles = enable; }
+    int getStaleHandleResolves() const { return m_staleHandleResolves; }
+
+    // Objects parked in the pools, all types
+    size_t getPooledObjectCount() const;
+
+    // Dormancy: the object's body is disabled and its update and render are skipped until
+    // a trigger fires or wakeObject is called. Calling it on a dormant object replaces the trigger.
+    void makeDormant(GameObject* obj, const DormancyTrigger& trigger = DormancyTrigger());
+    void wakeObject(GameObject* obj);
+    int getDormantObjectCount() const { return static_cast<int>(m_dormantObjects.size()); }
+    // Objects in the layers that are awake; walks the layers, meant for stats
+    int getActiveObjectCount() const;
+
+private:
+    void compactLayer(int layer);
+    void assignHandle(GameObject* obj);
+    void releaseHandle(GameObject* obj);
+    void reuseGameObject(GameObject* obj, Layer layer);
+    void setPooledComponentsActive(GameObject* obj, bool active);
+    void removeDormant(GameObject* obj);
+    void updateDormant(float deltaTime);
+    void renderPhysicsOverlay();
+
+public:
     void setGravity(const Vector2D& gravity);
 
 	int getScreenWidth() const { return m_screenWidth; }
 	int getScreenHeight() const { return m_screenHeight; }
     PhysicsWorld* getPhysicsWorld() { return m_physicsWorld; }
 
+    // Min, average and max of the physics profile and counters over the recent steps
+    PhysicsStatsSummary getPhysicsStats() const;
+    // Graph of the recent steps' physics time in the bottom-left corner, drawn over the level
+    void setPhysicsOverlay(bool enabled) { m_physicsOverlay = enabled; }
+    bool isPhysicsOverlayEnabled() const { return m_physicsOverlay; }
+
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+// What a level's PhysicsWorld runs on; see Level's constructor
+enum class PhysicsBackend : uint8_t
+{
+	Box2D,	// Full rigid body simulation
+	Arcade	// Velocity integration and AABB overlap events only (ArcadeWorld)
+};
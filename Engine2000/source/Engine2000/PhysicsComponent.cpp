@@ -17,11 +17,20 @@ public:
 	b2BodyId bodyId;
 	b2ShapeId collisionShapeId;
 	b2ShapeId sensorShapeId;
+	// From the world's body pool: the size it is bucketed by, and the shapes the body
+	// came back with until createShape claims them (collision, sensor)
+	Vector2D poolSize;
+	b2ShapeId spareShapes[2];
 	PhysicsSensorListener* sensorListener;
+	PhysicsContactListener* contactListener;
 	bool sensorEventsEnabled;
+	bool hitEventsEnabled;
+	bool dormant;
+	Vector2D dormantVelocity;
 	bool isDynamic;
 	bool isBullet;
 	std::string layer;
+	int layerIndex;
 
 	// Debug
 	bool debugDraw;
@@ -49,11 +58,18 @@ public:
 		, bodyId(b2_nullBodyId)
 		, collisionShapeId(b2_nullShapeId)
 		, sensorShapeId(b2_nullShapeId)
+		, poolSize(0.0f, 0.0f)
+		, spareShapes{ b2_nullShapeId, b2_nullShapeId }
 		, sensorListener(nullptr)
+		, contactListener(nullptr)
 		, sensorEventsEnabled(false)
+		, hitEventsEnabled(false)
+		, dormant(false)
+		, dormantVelocity(0.0f, 0.0f)
 		, isDynamic(false)
 		, isBullet(false)
 		, layer("Default")
+		, layerIndex(0)
 		, debugDraw(false)
 		, isOverlapping(false)
 		, debugColor(DebugColor::Green) // Default green
@@ -63,23 +79,36 @@ public:
 		, m_isImmune(false)
 	{}
 
-	b2ShapeId createShape(b2BodyId bodyId, float width, float height, bool isSensor, bool enableSensorEvents) {
-		b2ShapeDef shapeDef = b2DefaultShapeDef();
-		shapeDef.isSensor = isSensor;
-		shapeDef.enableSensorEvents = enableSensorEvents;
-		shapeDef.density = 1.0f;
-		shapeDef.restitution = 0.0f;
-		shapeDef.friction = 0.0f;
+	b2Filter layerFilter() const {
+		const PhysicsLayerManager& layers = PhysicsLayerManager::getInstance();
+		b2Filter filter = b2DefaultFilter();
+		filter.categoryBits = layers.getCategoryBits(layerIndex);
+		filter.maskBits = layers.getMaskBits(layerIndex);
+		return filter;
+	}
+
+	b2Filter sensorFilter() const {
+		b2Filter filter = b2DefaultFilter();
+		filter.categoryBits = PhysicsLayerManager::SENSOR_CATEGORY;
+		filter.maskBits = PhysicsLayerManager::ALL_LAYERS;
+		return filter;
+	}
+
+	// Body and shapes live in the world, whichever backend it runs
+	bool hasBody() const {
+		return physicsWorld && physicsWorld->isBodyValid(bodyId);
+	}
 
-		// Set layer information
-		shapeDef.userData = const_cast<char*>(layer.c_str());
-		//E2_LOG(Log, "Creating shape - IsSensor: %d, SensorEvents: %d", shapeDef.isSensor, shapeDef.enableSensorEvents);
+	bool hasShape(b2ShapeId shapeId) const {
+		return physicsWorld && physicsWorld->isShapeValid(shapeId);
+	}
 
-		b2Vec2 boxCenter = { width / 2.0f, height / 2.0f };
-		b2Rot rotation = { 1.0f, 0.0f };
-		b2Polygon box = b2MakeOffsetBox(width / 2.0f, height / 2.0f, boxCenter, rotation);
-		
-		return b2CreatePolygonShape(bodyId, &shapeDef, &box);
+	b2ShapeId createShape(PhysicsComponent* component, float width, float height, bool isSensor) {
+		// Box2D rejects pairs from the layer bits in the broadphase
+		b2Filter filter = isSensor ? sensorFilter() : layerFilter();
+		//E2_LOG(Log, "Creating shape - IsSensor: %d", isSensor);
+		return physicsWorld->createComponentShape(component, width, height, isSensor, filter, hitEventsEnabled,
+			spareShapes[isSensor ? 1 : 0]);
 	}
 
 private:
@@ -133,10 +162,10 @@ private:
 public:
 	void render(GameObject* owner)
 	{
-		if (!debugDraw || !b2Shape_IsValid(collisionShapeId)) return;
+		if (!debugDraw || !hasShape(collisionShapeId)) return;
 
 		// Get shape bounds
-		b2AABB aabb = b2Shape_GetAABB(collisionShapeId);
+		Vector4D rect = physicsWorld->getShapeBounds(collisionShapeId);
 
 		// Get Box2D color based on state
 		b2HexColor box2dColor = isOverlapping ?
@@ -148,16 +177,9 @@ public:
 		uint8_t g = (box2dColor >> 8) & 0xFF;
 		uint8_t b = box2dColor & 0xFF;
 
-		Vector4D rect(
-			aabb.lowerBound.x,
-			aabb.lowerBound.y,
-			aabb.upperBound.x - aabb.lowerBound.x,
-			aabb.upperBound.y - aabb.lowerBound.y
-		);
-
 		Vector4D color(r, g, b, 127);  // 127 for half transparency
 
-		if (Renderer::Instance().isOpenGL()) {
+		if (Renderer::Instance().getBackend() != RenderBackend::SDL) {
 			// Draw filled shape with alpha
 			Renderer::Instance().fillRect(rect, color);
 
@@ -201,7 +223,7 @@ PhysicsComponent::~PhysicsComponent()
 
 void PhysicsComponent::init(PhysicsWorld* world, bool isDynamic, bool isBullet)
 {
-	if (b2Body_IsValid(pimpl->bodyId)) {
+	if (pimpl->hasBody()) {
 		E2_LOG(Warning, "Body already exists for this component!");
 		return;
 	}
@@ -213,70 +235,61 @@ void PhysicsComponent::init(PhysicsWorld* world, bool isDynamic, bool isBullet)
 	auto transform = m_owner->getTransform();
 	auto position = transform->getPosition();
 
-	// Create physics body
-	pimpl->bodyId = world->createBody(position, isDynamic, isBullet);
-
-	// Set body properties
-	b2Body_SetLinearDamping(pimpl->bodyId, 0.0f);
-	b2Body_SetAngularDamping(pimpl->bodyId, 0.0f);
-	b2Body_SetGravityScale(pimpl->bodyId, 0.0f);
-	b2Body_SetFixedRotation(pimpl->bodyId, true);
-
-	if (!isDynamic)
-	{
-		b2Body_SetType(pimpl->bodyId, b2_kinematicBody);
+	// Objects of one kind share a sprite size, so it picks the pool their bodies return to
+	pimpl->poolSize = Vector2D(0.0f, 0.0f);
+	if (auto sprite = m_owner->getComponent<SpriteComponent>()) {
+		pimpl->poolSize = Vector2D(static_cast<float>(sprite->getFrameWidth()), static_cast<float>(sprite->getFrameHeight()));
 	}
 
-	b2Body_SetUserData(pimpl->bodyId, this);
+	// Create physics body
+	pimpl->bodyId = world->createComponentBody(this, position, isDynamic, isBullet, pimpl->poolSize, pimpl->spareShapes);
 
-	if (m_owner && b2Body_IsValid(pimpl->bodyId)) {
-		b2Vec2 pos = b2Body_GetPosition(pimpl->bodyId);
+	if (m_owner && pimpl->hasBody()) {
+		Vector2D pos = world->getBodyPosition(pimpl->bodyId);
 		m_owner->getTransform()->setPosition(pos.x, pos.y);
 	}
 }
 
 void PhysicsComponent::cleanup()
 {
-	if (pimpl->physicsWorld && b2Body_IsValid(pimpl->bodyId)) {
-		if (b2Shape_IsValid(pimpl->collisionShapeId)) {
-			b2DestroyShape(pimpl->collisionShapeId, false);
-			pimpl->collisionShapeId = b2_nullShapeId;
-		}
-
-		if (b2Shape_IsValid(pimpl->sensorShapeId)) {
-			b2DestroyShape(pimpl->sensorShapeId, false);
-			pimpl->sensorShapeId = b2_nullShapeId;
-		}
+	if (pimpl->hasBody()) {
+		// Unclaimed spares go back with the body, still inert
+		b2ShapeId shapes[2] = {
+			pimpl->hasShape(pimpl->collisionShapeId) ? pimpl->collisionShapeId : pimpl->spareShapes[0],
+			pimpl->hasShape(pimpl->sensorShapeId) ? pimpl->sensorShapeId : pimpl->spareShapes[1]
+		};
+		pimpl->physicsWorld->releaseComponentBody(pimpl->bodyId, pimpl->isDynamic, pimpl->isBullet, pimpl->poolSize, shapes);
 
-		pimpl->physicsWorld->destroyBody(pimpl->bodyId);
+		pimpl->collisionShapeId = b2_nullShapeId;
+		pimpl->sensorShapeId = b2_nullShapeId;
+		pimpl->spareShapes[0] = b2_nullShapeId;
+		pimpl->spareShapes[1] = b2_nullShapeId;
 		pimpl->bodyId = b2_nullBodyId;
+		pimpl->dormant = false;
 	}
 }
 
 void PhysicsComponent::update(float deltaTime)
 {
-	if (!pimpl->physicsWorld || !b2Body_IsValid(pimpl->bodyId)) return;
-
+	// The transform follows the body through PhysicsWorld's move events
 	if (pimpl->m_isImmune) {
 		pimpl->m_immunityTimer -= deltaTime;
 		if (pimpl->m_immunityTimer <= 0) {
 			pimpl->m_isImmune = false;
 		}
 	}
-
-	// Update GameObject position based on physics simulation
-	auto position = pimpl->physicsWorld->getBodyPosition(pimpl->bodyId);
-	m_owner->getTransform()->setPosition(position.x, position.y);
 }
 
 void PhysicsComponent::setLayer(const std::string& layerName)
 {
-	if (PhysicsLayerManager::getInstance().getLayerIndex(layerName) != -1)
+	int layerIndex = PhysicsLayerManager::getInstance().getLayerIndex(layerName);
+	if (layerIndex != -1)
 	{
 		pimpl->layer = layerName;
-		if (b2Shape_IsValid(pimpl->collisionShapeId))
+		pimpl->layerIndex = layerIndex;
+		if (pimpl->hasShape(pimpl->collisionShapeId))
 		{
-			b2Shape_SetUserData(pimpl->collisionShapeId, const_cast<char*>(pimpl->layer.c_str()));
+			pimpl->physicsWorld->setShapeFilter(pimpl->collisionShapeId, pimpl->layerFilter());
 			//E2_LOG(Log, "Physics layer changed to: %s", pimpl->layer.c_str());
 		}
 	}
@@ -293,28 +306,28 @@ const std::string& PhysicsComponent::getLayer() const
 
 void PhysicsComponent::createCollisionShape(float width, float height)
 {
-	if (b2Shape_IsValid(pimpl->collisionShapeId)) {
+	if (pimpl->hasShape(pimpl->collisionShapeId)) {
 		E2_LOG(Warning, "Collision shape already exists!");
 		return;
 	}
 
-	pimpl->sensorShapeId = pimpl->createShape(pimpl->bodyId, width, height, false, false);
+	pimpl->collisionShapeId = pimpl->createShape(this, width, height, false);
 	//E2_LOG(Log, "Created collision shape: %d", pimpl->collisionShapeId.index1);
 }
 
 void PhysicsComponent::createSensorShape(float width, float height)
 {
-	if (b2Shape_IsValid(pimpl->sensorShapeId)) {
+	if (pimpl->hasShape(pimpl->sensorShapeId)) {
 		E2_LOG(Warning, "Sensor shape already exists!");
 		return;
 	}
 
-	pimpl->sensorShapeId = pimpl->createShape(pimpl->bodyId, width, height, true, true);
+	pimpl->sensorShapeId = pimpl->createShape(this, width, height, true);
 	//E2_LOG(Log, "Created sensor shape: %d", pimpl->sensorShapeId.index1);
 }
 
 void PhysicsComponent::createCollisionShapeFromSprite() {
-	if (b2Shape_IsValid(pimpl->collisionShapeId)) {
+	if (pimpl->hasShape(pimpl->collisionShapeId)) {
 		E2_LOG(Warning, "Collision shape already exists!");
 		return;
 	}
@@ -336,11 +349,11 @@ void PhysicsComponent::createCollisionShapeFromSprite() {
 		E2_LOG(Warning, "No sprite found for physics component, creating collision shape using default 1x1 box");
 	}
 
-	pimpl->collisionShapeId = pimpl->createShape(pimpl->bodyId, width, height, false, false);
+	pimpl->collisionShapeId = pimpl->createShape(this, width, height, false);
 }
 
 void PhysicsComponent::createSensorShapeFromSprite(float scaleFactor, PhysicsSensorListener* listener) {
-	if (b2Shape_IsValid(pimpl->sensorShapeId)) {
+	if (pimpl->hasShape(pimpl->sensorShapeId)) {
 		E2_LOG(Warning, "Sensor shape already exists!");
 		return;
 	}
@@ -364,7 +377,7 @@ void PhysicsComponent::createSensorShapeFromSprite(float scaleFactor, PhysicsSen
 		height *= scaleFactor;
 	}
 
-	pimpl->sensorShapeId = pimpl->createShape(pimpl->bodyId, width, height, true, true);
+	pimpl->sensorShapeId = pimpl->createShape(this, width, height, true);
 	//E2_LOG(Log, "Created sensor shape: %d", pimpl->sensorShapeId.index1);
 
 	// Automatically enable sensor events.
@@ -384,18 +397,18 @@ void PhysicsComponent::createSensorShapeFromSprite(PhysicsSensorListener* listen
 void PhysicsComponent::enableSensorEvents()
 {
 	pimpl->sensorEventsEnabled = true;
-	if (b2Shape_IsValid(pimpl->sensorShapeId))
+	if (pimpl->hasShape(pimpl->sensorShapeId))
 	{
-		b2Shape_EnableSensorEvents(pimpl->sensorShapeId, true);
+		pimpl->physicsWorld->enableSensorEvents(pimpl->sensorShapeId, true);
 	}
 }
 
 void PhysicsComponent::disableSensorEvents()
 {
 	pimpl->sensorEventsEnabled = false;
-	if (b2Shape_IsValid(pimpl->sensorShapeId))
+	if (pimpl->hasShape(pimpl->sensorShapeId))
 	{
-		b2Shape_EnableSensorEvents(pimpl->sensorShapeId, false);
+		pimpl->physicsWorld->enableSensorEvents(pimpl->sensorShapeId, false);
 	}
 }
 
@@ -429,6 +442,44 @@ void PhysicsComponent::handleSensorEnd(GameObject* other)
 	}
 }
 
+void PhysicsComponent::setContactListener(PhysicsContactListener* listener)
+{
+	pimpl->contactListener = listener;
+}
+
+void PhysicsComponent::enableHitEvents(bool enable)
+{
+	pimpl->hitEventsEnabled = enable;
+	if (pimpl->hasShape(pimpl->collisionShapeId))
+	{
+		pimpl->physicsWorld->enableHitEvents(pimpl->collisionShapeId, enable);
+	}
+}
+
+void PhysicsComponent::handleContactBegin(GameObject* other)
+{
+	if (pimpl->contactListener)
+	{
+		pimpl->contactListener->onContactBegin(other);
+	}
+}
+
+void PhysicsComponent::handleContactEnd(GameObject* other)
+{
+	if (pimpl->contactListener)
+	{
+		pimpl->contactListener->onContactEnd(other);
+	}
+}
+
+void PhysicsComponent::handleHit(GameObject* other, float approachSpeed)
+{
+	if (pimpl->contactListener)
+	{
+		pimpl->contactListener->onHit(other, approachSpeed);
+	}
+}
+
 void PhysicsComponent::setDebugDraw(bool enable)
 {
 	pimpl->debugDraw = enable;
@@ -456,6 +507,12 @@ void PhysicsComponent::setImmunity(float duration)
 	pimpl->m_isImmune = true;
 }
 
+void PhysicsComponent::clearImmunity()
+{
+	pimpl->m_immunityTimer = 0.0f;
+	pimpl->m_isImmune = false;
+}
+
 bool PhysicsComponent::isImmune() const
 {
 	return pimpl->m_isImmune;
@@ -468,33 +525,80 @@ bool PhysicsComponent::areSensorEventsEnabled() const
 
 void PhysicsComponent::setPosition(const Vector2D& position)
 {
-	if (pimpl->physicsWorld && b2Body_IsValid(pimpl->bodyId))
+	if (pimpl->hasBody())
 	{
 		pimpl->physicsWorld->setBodyPosition(pimpl->bodyId, position);
+
+		// A teleport reports no move event, so the transform is set here
+		m_owner->getTransform()->setPosition(position);
 	}
 }
 
 void PhysicsComponent::setVelocity(const Vector2D& velocity)
 {
-	if (pimpl->physicsWorld && b2Body_IsValid(pimpl->bodyId))
+	// Kinematic and dynamic bodies alike take it scaled by the world
+	if (pimpl->hasBody())
 	{
-		// If it's kinematic, set linear velocity directly with scaling
-		if (!pimpl->isDynamic)
-		{
-			Vector2D scaledVelocity = velocity * PhysicsWorld::getVelocityScale();
-			b2Body_SetLinearVelocity(pimpl->bodyId, { scaledVelocity.x, scaledVelocity.y });
-		}
-		else
-		{
-			// For dynamic bodies, use PhysicsWorld's method which handles scaling
-			pimpl->physicsWorld->setBodyVelocity(pimpl->bodyId, velocity);
-		}
+		pimpl->physicsWorld->setBodyVelocity(pimpl->bodyId, velocity);
 	}
 }
 
+void PhysicsComponent::setBodyEnabled(bool enabled)
+{
+	if (!pimpl->hasBody()) return;
+
+	if (!enabled)
+	{
+		pimpl->physicsWorld->restoreBodyVelocity(pimpl->bodyId, Vector2D(0.0f, 0.0f));
+		pimpl->isOverlapping = false;
+	}
+	pimpl->physicsWorld->setBodyEnabled(pimpl->bodyId, enabled);
+}
+
+void PhysicsComponent::setDormant(bool dormant)
+{
+	if (!pimpl->hasBody() || pimpl->dormant == dormant) return;
+	pimpl->dormant = dormant;
+
+	if (dormant)
+	{
+		pimpl->dormantVelocity = pimpl->physicsWorld->getBodyVelocity(pimpl->bodyId);
+		pimpl->physicsWorld->setBodyEnabled(pimpl->bodyId, false);
+		pimpl->isOverlapping = false;
+	}
+	else
+	{
+		// The transform may have drifted or been moved while the body was out
+		pimpl->physicsWorld->setBodyPosition(pimpl->bodyId, m_owner->getTransform()->getPosition());
+		pimpl->physicsWorld->setBodyEnabled(pimpl->bodyId, true);
+		pimpl->physicsWorld->restoreBodyVelocity(pimpl->bodyId, pimpl->dormantVelocity);
+	}
+}
+
+bool PhysicsComponent::isDormant() const
+{
+	return pimpl->dormant;
+}
+
+void PhysicsComponent::advanceDormant(float timeStep)
+{
+	if (!pimpl->dormant) return;
+
+	// Same integration Box2D does for an undamped body without gravity
+	TransformComponent* transform = m_owner->getTransform();
+	Vector2D position = transform->getPosition();
+	transform->setPosition(position.x + pimpl->dormantVelocity.x * timeStep,
+		position.y + pimpl->dormantVelocity.y * timeStep);
+}
+
+bool PhysicsComponent::isBodyEnabled() const
+{
+	return pimpl->hasBody() && pimpl->physicsWorld->isBodyEnabled(pimpl->bodyId);
+}
+
 Vector2D PhysicsComponent::getVelocity()
 {
-	if (pimpl->physicsWorld && b2Body_IsValid(pimpl->bodyId))
+	if (pimpl->hasBody())
 	{
 		return pimpl->physicsWorld->getBodyVelocity(pimpl->bodyId);
 	}
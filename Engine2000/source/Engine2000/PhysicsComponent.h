@@ -21,6 +21,16 @@ public:
 	virtual void onSensorEnd(GameObject* other) {}
 };
 
+// Solid (non-sensor) shapes touching; hits need enableHitEvents
+class ENGINE2000_API PhysicsContactListener
+{
+public:
+	virtual ~PhysicsContactListener() = default;
+	virtual void onContactBegin(GameObject* other) {}
+	virtual void onContactEnd(GameObject* other) {}
+	virtual void onHit(GameObject* other, float approachSpeed) {}
+};
+
 class ENGINE2000_API PhysicsComponent : public Component
 {
 private:
@@ -53,6 +63,17 @@ public:
 	void initializeBody();
 	void setVelocity(const Vector2D& velocity);
 	Vector2D getVelocity();
+
+	// A disabled body keeps its shapes but leaves the simulation; used by pooled objects
+	void setBodyEnabled(bool enabled);
+	bool isBodyEnabled() const;
+	// Dormancy (Level::makeDormant): the body leaves the simulation but keeps its velocity,
+	// and is moved to the transform's position when it comes back
+	void setDormant(bool dormant);
+	bool isDormant() const;
+	// Moves the transform along the kept velocity for one physics step
+	void advanceDormant(float timeStep);
+
 	b2BodyId getBodyId() const;
 	b2ShapeId getCollisionShapeId() const;
 	b2ShapeId getSensorShapeId() const;
@@ -73,6 +94,13 @@ public:
 	void handleSensorBegin(GameObject* other);
 	void handleSensorEnd(GameObject* other);
 
+	// Contact events, dispatched by PhysicsWorld after the step like sensor events
+	void setContactListener(PhysicsContactListener* listener);
+	void enableHitEvents(bool enable);
+	void handleContactBegin(GameObject* other);
+	void handleContactEnd(GameObject* other);
+	void handleHit(GameObject* other, float approachSpeed);
+
 	// Debug visualization
 	void setDebugDraw(bool enable);
 	void setDebugColor(DebugColor color);
@@ -80,5 +108,6 @@ public:
 	virtual void render() override;
 
 	void setImmunity(float duration);
+	void clearImmunity();
 	bool isImmune() const;
 };
\ No newline at end of file
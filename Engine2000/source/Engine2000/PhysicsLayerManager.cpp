@@ -33,9 +33,7 @@ PhysicsLayerManager::PhysicsLayerManager() {
 
 	// By default, everything collides with everything
 	for (int i = 0; i < MAX_LAYERS; ++i) {
-		for (int j = 0; j < MAX_LAYERS; ++j) {
-			m_collisionMatrix[i][j] = true;
-		}
+		m_collisionMasks[i] = 0xFFFFFFFFu;
 	}
 
 	initializeDefaultCollisions();
@@ -43,19 +41,24 @@ PhysicsLayerManager::PhysicsLayerManager() {
 }
 
 void PhysicsLayerManager::initializeDefaultCollisions() {
+	const int background = getLayerIndex("Background");
+	const int ui = getLayerIndex("UI");
+	const int trigger = getLayerIndex("Trigger");
+
+	// Layers created later start out colliding with these; games opt them out explicitly
 	// Background doesn't collide with anything
-	for (int i = 0; i < MAX_LAYERS; ++i) {
-		setLayerCollision("Background", m_layerNames[i], false);
+	for (int i = 0; i < BUILT_IN_LAYERS; ++i) {
+		setLayerCollision(background, i, false);
 	}
 
 	// UI doesn't collide with anything
-	for (int i = 0; i < MAX_LAYERS; ++i) {
-		setLayerCollision("UI", m_layerNames[i], false);
+	for (int i = 0; i < BUILT_IN_LAYERS; ++i) {
+		setLayerCollision(ui, i, false);
 	}
 
 	// Triggers don't physically collide but still detect overlap
-	for (int i = 0; i < MAX_LAYERS; ++i) {
-		setLayerCollision("Trigger", m_layerNames[i], false);
+	for (int i = 0; i < BUILT_IN_LAYERS; ++i) {
+		setLayerCollision(trigger, i, false);
 	}
 
 	// Environment collides with everything except Background, UI, and Trigger
@@ -102,15 +105,28 @@ bool PhysicsLayerManager::renameLayer(int index, const std::string& newName) {
 	return true;
 }
 
+void PhysicsLayerManager::setLayerCollision(int layer1, int layer2, bool shouldCollide) {
+	if (layer1 < 0 || layer1 >= MAX_LAYERS || layer2 < 0 || layer2 >= MAX_LAYERS) {
+		E2_LOG(Warning, "Failed to set collision: invalid layer indices %d, %d", layer1, layer2);
+		return;
+	}
+
+	if (shouldCollide) {
+		m_collisionMasks[layer1] |= 1u << layer2;
+		m_collisionMasks[layer2] |= 1u << layer1;
+	}
+	else {
+		m_collisionMasks[layer1] &= ~(1u << layer2);
+		m_collisionMasks[layer2] &= ~(1u << layer1);
+	}
+}
+
 void PhysicsLayerManager::setLayerCollision(const std::string& layer1, const std::string& layer2, bool shouldCollide) {
 	auto it1 = m_layerNameToIndex.find(layer1);
 	auto it2 = m_layerNameToIndex.find(layer2);
 
 	if (it1 != m_layerNameToIndex.end() && it2 != m_layerNameToIndex.end()) {
-		int i = it1->second;
-		int j = it2->second;
-		m_collisionMatrix[i][j] = shouldCollide;
-		m_collisionMatrix[j][i] = shouldCollide;
+		setLayerCollision(it1->second, it2->second, shouldCollide);
 		E2_LOG(Log, "Set collision between '%s' and '%s' to %s",
 			layer1.c_str(), layer2.c_str(), shouldCollide ? "true" : "false");
 	}
@@ -119,14 +135,24 @@ void PhysicsLayerManager::setLayerCollision(const std::string& layer1, const std
 	}
 }
 
+bool PhysicsLayerManager::shouldLayersCollide(int layer1, int layer2) const {
+	if (layer1 < 0 || layer1 >= MAX_LAYERS || layer2 < 0 || layer2 >= MAX_LAYERS) {
+		return false;
+	}
+	return (m_collisionMasks[layer1] >> layer2) & 1u;
+}
+
 bool PhysicsLayerManager::shouldLayersCollide(const std::string& layer1, const std::string& layer2) const {
-	auto it1 = m_layerNameToIndex.find(layer1);
-	auto it2 = m_layerNameToIndex.find(layer2);
+	return shouldLayersCollide(getLayerIndex(layer1), getLayerIndex(layer2));
+}
 
-	if (it1 != m_layerNameToIndex.end() && it2 != m_layerNameToIndex.end()) {
-		return m_collisionMatrix[it1->second][it2->second];
-	}
-	return false;
+uint64_t PhysicsLayerManager::getCategoryBits(int layer) const {
+	return (layer >= 0 && layer < MAX_LAYERS) ? (1ull << layer) : 0;
+}
+
+uint64_t PhysicsLayerManager::getMaskBits(int layer) const {
+	uint64_t mask = (layer >= 0 && layer < MAX_LAYERS) ? m_collisionMasks[layer] : 0;
+	return mask | SENSOR_CATEGORY;
 }
 
 const std::string& PhysicsLayerManager::getLayerName(int index) const {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Core.h"
+#include <cstdint>
 #include <string>
 #include <array>
 #include <unordered_map>
@@ -10,10 +11,15 @@ public:
 	static constexpr int MAX_LAYERS = 32;
 	static constexpr int BUILT_IN_LAYERS = 8;
 
+	// Layers are b2Filter category bits 0..31. Sensor shapes use the bit above them and
+	// every layer's mask includes it, so sensors see all layers as they always have.
+	static constexpr uint64_t SENSOR_CATEGORY = 1ull << MAX_LAYERS;
+	static constexpr uint64_t ALL_LAYERS = SENSOR_CATEGORY - 1;
+
 private:
 	std::unordered_map<std::string, int> m_layerNameToIndex;
 	std::array<std::string, MAX_LAYERS> m_layerNames;
-	bool m_collisionMatrix[MAX_LAYERS][MAX_LAYERS];
+	uint32_t m_collisionMasks[MAX_LAYERS];	// Bit j of mask i: layers i and j collide
 	static PhysicsLayerManager* s_instance;
 
 public:
@@ -30,10 +36,17 @@ public:
 	bool createLayer(const std::string& name, int* outIndex = nullptr);
 	bool renameLayer(int index, const std::string& newName);
 
-	// Collision management
+	// Collision management. Shapes read the masks when they are created or change layer,
+	// so set the rules up before spawning objects
+	void setLayerCollision(int layer1, int layer2, bool shouldCollide);
 	void setLayerCollision(const std::string& layer1, const std::string& layer2, bool shouldCollide);
+	bool shouldLayersCollide(int layer1, int layer2) const;
 	bool shouldLayersCollide(const std::string& layer1, const std::string& layer2) const;
 
+	// b2Filter bits for a solid shape on a layer
+	uint64_t getCategoryBits(int layer) const;
+	uint64_t getMaskBits(int layer) const;
+
 	// Getters
 	const std::string& getLayerName(int index) const;
 	int getLayerIndex(const std::string& name) const;
@@ -1,41 +1,74 @@
 #include "PhysicsWorld.h"
 #include "EngineError.h"
-#include "PhysicsLayerManager.h"
 #include "PhysicsComponent.h"
+#include "ScreenBoundsComponent.h"
+#include "ArcadeWorld.h"
+#include "GameObject.h"
+#include "TransformComponent.h"
 #include "Renderer.h"
 #include "E2Log.h"
+#include "Profiler.h"
+#include "Platform.h"
+#include <algorithm>
+#include <cmath>
 
 const float PhysicsWorld::VELOCITY_SCALE = 0.30f;
+// Gameplay was tuned stepping Box2D by 1/5 s per frame at about 60 fps; real time
+// is scaled by the same ratio so the fixed-step loop keeps that feel at any rate
+const float PhysicsWorld::TIME_SCALE = 12.0f;
 
-bool PhysicsWorld::filterCallback(b2ShapeId shapeIdA, b2ShapeId shapeIdB, void* context)
+void* PhysicsWorld::enqueueTask(b2TaskCallback* task, int32_t itemCount, int32_t minRange, void* taskContext, void* userContext)
 {
-	// Get layer names from shape user data 
-	const char* layerA = static_cast<const char*>(b2Shape_GetUserData(shapeIdA));
-	const char* layerB = static_cast<const char*>(b2Shape_GetUserData(shapeIdB));
+	PhysicsWorld* world = static_cast<PhysicsWorld*>(userContext);
 
-	// If either shape is a sensor with events enabled, allow the detection
-	bool sensorEventsA = b2Shape_AreSensorEventsEnabled(shapeIdA);
-	bool sensorEventsB = b2Shape_AreSensorEventsEnabled(shapeIdB);
-	
-	if(!PhysicsLayerManager::getInstance().shouldLayersCollide(layerA, layerB))
+	// Never run inline: a solver worker task spins until the stepping thread signals its
+	// stages, which cannot happen while that thread is stuck in here. Box2D only enqueues
+	// from the stepping thread, so growing the deque here is safe.
+	if (world->m_taskCount == static_cast<int>(world->m_taskCounters.size()))
 	{
-		if (sensorEventsA || sensorEventsB) {
-			return true;  // Allow sensor detection
-		}
+		world->m_taskCounters.emplace_back();
 	}
 
-	// For physical collisions, use the layer matrix
-	return PhysicsLayerManager::getInstance().shouldLayersCollide(layerA, layerB);
+	// Range i runs as Box2D worker i, so no two threads ever share a worker's scratch data
+	int ranges = std::min(world->m_workerCount, (itemCount + minRange - 1) / minRange);
+	int rangeSize = (itemCount + ranges - 1) / ranges;
+
+	JobCounter* counter = &world->m_taskCounters[world->m_taskCount++];
+	for (int i = 0; i < ranges; i++)
+	{
+		int start = i * rangeSize;
+		int end = std::min(start + rangeSize, itemCount);
+		if (start >= end) break;
+
+		JobSystem::Instance().submit([task, start, end, i, taskContext] {
+			task(start, end, static_cast<uint32_t>(i), taskContext);
+		}, counter);
+	}
+	return counter;
+}
+
+void PhysicsWorld::finishTask(void* userTask, void* userContext)
+{
+	JobSystem::Instance().wait(*static_cast<JobCounter*>(userTask));
 }
 
 PhysicsWorld::PhysicsWorld()
-	: m_timeStep(1.0f / 5.0f)
+	: m_backend(PhysicsBackend::Box2D)
+	, m_arcade(nullptr)
+	, m_timeStep(1.0f / 5.0f)
 	, m_subSteps(4)
 	, m_worldWidth(0)
 	, m_worldHeight(0)
 	, m_gravity(0.0f, 0.0f)
 	, m_worldId(b2_nullWorldId)
 	, m_debugDraw(false)
+	, m_workerCount(1)
+	, m_taskCount(0)
+	, m_movedBodies(0)
+	, m_stepCount(0)
+	, m_statsHistory(STATS_HISTORY)
+	, m_statsNext(0)
+	, m_statsCount(0)
 {
 }
 
@@ -44,41 +77,110 @@ PhysicsWorld::~PhysicsWorld()
 	cleanup();
 }
 
-void PhysicsWorld::init(float worldWidth, float worldHeight, const Vector2D& gravity = Vector2D(0.0f, 0.0f))
+void PhysicsWorld::init(float worldWidth, float worldHeight, const Vector2D& gravity, int threadCount, PhysicsBackend backend)
 {
 	m_worldWidth = worldWidth;
 	m_worldHeight = worldHeight;
 	m_gravity = gravity;
+	m_backend = backend;
+
+	if (m_backend == PhysicsBackend::Arcade)
+	{
+		m_workerCount = 1;
+		m_arcade = new ArcadeWorld();
+		E2_LOG(Log, "PhysicsWorld initialized: %fx%f, arcade backend", worldWidth, worldHeight);
+		return;
+	}
+
+	// More Box2D workers than threads would only queue up behind each other
+	int availableThreads = JobSystem::Instance().getWorkerCount() + 1;
+	m_workerCount = threadCount > 0 ? std::min(threadCount, availableThreads) : availableThreads;
 
 	b2WorldDef worldDef = b2DefaultWorldDef();
 	worldDef.gravity = {m_gravity.x, m_gravity.y};
+	if (m_workerCount > 1)
+	{
+		worldDef.workerCount = m_workerCount;
+		worldDef.enqueueTask = enqueueTask;
+		worldDef.finishTask = finishTask;
+		worldDef.userTaskContext = this;
+
+		// JobCounter cannot move, so the deque is filled in place
+		m_taskCounters.clear();
+		for (int i = 0; i < m_workerCount + FIXED_STEP_TASKS; i++)
+		{
+			m_taskCounters.emplace_back();
+		}
+	}
 
 	m_worldId = b2CreateWorld(&worldDef);
 	if (!b2World_IsValid(m_worldId)) {
 		throw EngineError("Failed to create Box2D world");
 	}
 
-	// Set up collision filtering
-	b2World_SetCustomFilterCallback(m_worldId, filterCallback, this);
-
-	E2_LOG(Log, "PhysicsWorld initialized: %fx%f with gravity (%f, %f)",
-		worldWidth, worldHeight, gravity.x, gravity.y);
+	E2_LOG(Log, "PhysicsWorld initialized: %fx%f with gravity (%f, %f), %d thread(s)",
+		worldWidth, worldHeight, gravity.x, gravity.y, m_workerCount);
 }
 
 
 void PhysicsWorld::cleanup()
 {
+	delete m_arcade;
+	m_arcade = nullptr;
+
 	if (b2World_IsValid(m_worldId)) {
+		logPoolStats();
+
+		// Pooled bodies go with the world
+		m_bodyPools.clear();
+		m_bodyArmedStep.clear();
+		m_poolStats.pooledBodies = 0;
+
 		b2DestroyWorld(m_worldId);
 		m_worldId = b2_nullWorldId;
 	}
 }
 
-void PhysicsWorld::update()
+void PhysicsWorld::update(float deltaTime)
 {
-	if (b2World_IsValid(m_worldId)) {
-		b2World_Step(m_worldId, m_timeStep, m_subSteps);
-		processSensors();
+	if (m_arcade) {
+		m_timeStep = deltaTime * TIME_SCALE;
+		float stepMs = 0.0f;
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::step");
+			uint64_t start = Platform::getCounter();
+			m_arcade->step(m_timeStep);
+			stepMs = static_cast<float>(1000.0 * (Platform::getCounter() - start) / Platform::getCounterFrequency());
+		}
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::syncMovedBodies");
+			syncArcadeBodies();
+		}
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::events");
+			gatherArcadeEvents();
+			dispatchEvents();
+		}
+		recordStepStats(stepMs);
+	}
+	else if (b2World_IsValid(m_worldId)) {
+		m_timeStep = deltaTime * TIME_SCALE;
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::step");
+			m_taskCount = 0;
+			m_stepCount++;
+			b2World_Step(m_worldId, m_timeStep, m_subSteps);
+		}
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::syncMovedBodies");
+			syncMovedBodies();
+		}
+		{
+			E2_PROFILE_SCOPE("PhysicsWorld::events");
+			gatherEvents();
+			dispatchEvents();
+		}
+		recordStepStats(0.0f);
 	}
 }
 
@@ -93,6 +195,11 @@ void PhysicsWorld::setGravity(const Vector2D& gravity) {
 
 b2BodyId PhysicsWorld::createBody(const Vector2D& position, bool isDynamic, bool isBullet)
 {
+	if (m_arcade) {
+		int index = m_arcade->createBody(position.x, position.y, isDynamic, nullptr);
+		return { index + 1, ARCADE_WORLD, m_arcade->getBody(index).generation };
+	}
+
 	b2BodyDef bodyDef = b2DefaultBodyDef();
 	bodyDef.position = { position.x, position.y};
 	bodyDef.type = isDynamic ? b2_dynamicBody : b2_staticBody;
@@ -101,10 +208,20 @@ b2BodyId PhysicsWorld::createBody(const Vector2D& position, bool isDynamic, bool
 	return b2CreateBody(m_worldId, &bodyDef);
 }
 
-b2ShapeId PhysicsWorld::createBoxShape(b2BodyId bodyId, float width, float height, float density)
+b2ShapeId PhysicsWorld::createBoxShape(b2BodyId bodyId, float width, float height, float density, bool isSensor)
 {
+	if (isArcade(bodyId)) {
+		int index = m_arcade->createShape(bodyId.index1 - 1, -width / 2.0f, -height / 2.0f, width, height,
+			isSensor, b2_defaultCategoryBits, b2_defaultMaskBits, nullptr);
+		return { index + 1, ARCADE_WORLD, m_arcade->getShape(index).generation };
+	}
+
 	b2ShapeDef shapeDef = b2DefaultShapeDef();
 	shapeDef.density = density;
+	if (isSensor) {
+		shapeDef.isSensor = true;
+		shapeDef.enableSensorEvents = true;
+	}
 
 	b2Polygon box = b2MakeBox(width / 2.0f, height / 2.0f);
 	return b2CreatePolygonShape(bodyId, &shapeDef, &box);
@@ -112,13 +229,22 @@ b2ShapeId PhysicsWorld::createBoxShape(b2BodyId bodyId, float width, float heigh
 
 void PhysicsWorld::destroyBody(b2BodyId bodyId)
 {
-	if (b2Body_IsValid(bodyId)) {
+	if (isArcade(bodyId)) {
+		if (isBodyValid(bodyId)) m_arcade->destroyBody(bodyId.index1 - 1);
+	}
+	else if (b2Body_IsValid(bodyId)) {
 		b2DestroyBody(bodyId);
 	}
 }
 
 Vector2D PhysicsWorld::getBodyPosition(b2BodyId bodyId)
 {
+	if (isArcade(bodyId)) {
+		if (!isBodyValid(bodyId)) return { 0.0f, 0.0f };
+		const ArcadeWorld::Body& body = m_arcade->getBody(bodyId.index1 - 1);
+		return { body.x, body.y };
+	}
+
 	if (!b2Body_IsValid(bodyId)) return { 0.0f, 0.0f };
 
 	b2Vec2 pos = b2Body_GetPosition(bodyId);
@@ -127,6 +253,12 @@ Vector2D PhysicsWorld::getBodyPosition(b2BodyId bodyId)
 
 Vector2D PhysicsWorld::getBodyVelocity(b2BodyId bodyId)
 {
+	if (isArcade(bodyId)) {
+		if (!isBodyValid(bodyId)) return { 0.0f, 0.0f };
+		const ArcadeWorld::Body& body = m_arcade->getBody(bodyId.index1 - 1);
+		return { body.vx, body.vy };
+	}
+
 	if (!b2Body_IsValid(bodyId)) return { 0.0f, 0.0f };
 
 	b2Vec2 vel = b2Body_GetLinearVelocity(bodyId);
@@ -135,6 +267,15 @@ Vector2D PhysicsWorld::getBodyVelocity(b2BodyId bodyId)
 
 void PhysicsWorld::setBodyPosition(b2BodyId bodyId, const Vector2D& position)
 {
+	if (isArcade(bodyId)) {
+		if (!isBodyValid(bodyId)) return;
+		ArcadeWorld::Body& body = m_arcade->getBody(bodyId.index1 - 1);
+		body.x = position.x;
+		body.y = position.y;
+		m_arcade->markBodyMoved(bodyId.index1 - 1);
+		return;
+	}
+
 	if (!b2Body_IsValid(bodyId)) return;
 
 	b2Rot currentRotation = b2Body_GetRotation(bodyId);
@@ -143,38 +284,844 @@ void PhysicsWorld::setBodyPosition(b2BodyId bodyId, const Vector2D& position)
 
 void PhysicsWorld::setBodyVelocity(b2BodyId bodyId, const Vector2D& velocity)
 {
+	restoreBodyVelocity(bodyId, velocity * VELOCITY_SCALE);
+}
+
+void PhysicsWorld::restoreBodyVelocity(b2BodyId bodyId, const Vector2D& velocity)
+{
+	if (isArcade(bodyId)) {
+		if (!isBodyValid(bodyId)) return;
+		ArcadeWorld::Body& body = m_arcade->getBody(bodyId.index1 - 1);
+		body.vx = velocity.x;
+		body.vy = velocity.y;
+		return;
+	}
+
 	if (!b2Body_IsValid(bodyId)) return;
-	Vector2D scaledVelocity = velocity * VELOCITY_SCALE;
-	b2Body_SetLinearVelocity(bodyId, { scaledVelocity.x, scaledVelocity.y });
+	b2Body_SetLinearVelocity(bodyId, { velocity.x, velocity.y });
 }
 
-void PhysicsWorld::processSensors()
+b2BodyId PhysicsWorld::createComponentBody(PhysicsComponent* component, const Vector2D& position, bool isDynamic, bool isBullet,
+	const Vector2D& poolSize, b2ShapeId spareShapes[2])
 {
-	b2SensorEvents sensorEvents = b2World_GetSensorEvents(m_worldId);
-	//E2_LOG(Warning, "Received sensor events: %d", sensorEvents.beginCount);
+	spareShapes[0] = b2_nullShapeId;
+	spareShapes[1] = b2_nullShapeId;
+
+	if (!m_arcade) {
+		auto bucket = m_bodyPools.find(poolKey(isDynamic, isBullet, poolSize));
+		if (bucket != m_bodyPools.end() && !bucket->second.empty()) {
+			PooledBody pooled = bucket->second.back();
+			bucket->second.pop_back();
+			m_poolStats.bodyHits++;
+			m_poolStats.pooledBodies--;
+
+			// Moved while disabled, so enabling puts its shapes straight into the broadphase
+			// where they belong; they stay inert until createComponentShape re-arms them
+			b2Body_SetTransform(pooled.bodyId, { position.x, position.y }, b2Rot_identity);
+			b2Body_Enable(pooled.bodyId);
+			b2Body_SetLinearVelocity(pooled.bodyId, { 0.0f, 0.0f });
+			b2Body_SetAngularVelocity(pooled.bodyId, 0.0f);
+			b2Body_SetUserData(pooled.bodyId, component);
+
+			uint32_t index = static_cast<uint32_t>(pooled.bodyId.index1);
+			if (index >= m_bodyArmedStep.size()) {
+				m_bodyArmedStep.resize(index + 1, 0);
+			}
+			m_bodyArmedStep[index] = m_stepCount + 1;
+
+			spareShapes[0] = pooled.shapes[0];
+			spareShapes[1] = pooled.shapes[1];
+			return pooled.bodyId;
+		}
+		m_poolStats.bodyMisses++;
+	}
+
+	b2BodyId bodyId = createBody(position, isDynamic, isBullet);
+
+	if (isArcade(bodyId)) {
+		m_arcade->getBody(bodyId.index1 - 1).userData = component;
+		return bodyId;
+	}
+
+	b2Body_SetLinearDamping(bodyId, 0.0f);
+	b2Body_SetAngularDamping(bodyId, 0.0f);
+	b2Body_SetGravityScale(bodyId, 0.0f);
+	b2Body_SetFixedRotation(bodyId, true);
+	if (!isDynamic)
+	{
+		b2Body_SetType(bodyId, b2_kinematicBody);
+	}
+	b2Body_SetUserData(bodyId, component);
+	return bodyId;
+}
+
+b2ShapeId PhysicsWorld::createComponentShape(PhysicsComponent* component, float width, float height, bool isSensor,
+	const b2Filter& filter, bool hitEvents, b2ShapeId& spare)
+{
+	b2BodyId bodyId = component->getBodyId();
+
+	if (isShapeValid(spare) && !isArcade(spare)) {
+		// Component boxes run from the body origin, so the far corner is the size
+		b2Polygon polygon = b2Shape_GetPolygon(spare);
+		bool sameSize = std::fabs(polygon.vertices[2].x - polygon.vertices[0].x - width) < 0.01f
+			&& std::fabs(polygon.vertices[2].y - polygon.vertices[0].y - height) < 0.01f;
+		if (sameSize && b2Shape_IsSensor(spare) == isSensor) {
+			b2ShapeId shapeId = spare;
+			spare = b2_nullShapeId;
+			m_poolStats.shapeHits++;
+
+			b2Shape_SetUserData(shapeId, component);
+			b2Shape_SetFilter(shapeId, filter);
+			b2Shape_EnableSensorEvents(shapeId, isSensor);
+			b2Shape_EnableHitEvents(shapeId, !isSensor && hitEvents);
+			return shapeId;
+		}
+		b2DestroyShape(spare, false);
+	}
+	spare = b2_nullShapeId;
+	if (!isArcade(bodyId)) {
+		m_poolStats.shapeMisses++;
+	}
+
+	// Events resolve straight to the component, without going through the body
+	if (isArcade(bodyId)) {
+		int index = m_arcade->createShape(bodyId.index1 - 1, 0.0f, 0.0f, width, height,
+			isSensor, filter.categoryBits, filter.maskBits, component);
+		return { index + 1, ARCADE_WORLD, m_arcade->getShape(index).generation };
+	}
+
+	b2ShapeDef shapeDef = b2DefaultShapeDef();
+	shapeDef.isSensor = isSensor;
+	shapeDef.enableSensorEvents = isSensor;
+	shapeDef.density = 1.0f;
+	shapeDef.restitution = 0.0f;
+	shapeDef.friction = 0.0f;
+	shapeDef.filter = filter;
+	shapeDef.userData = component;
+	shapeDef.enableHitEvents = !isSensor && hitEvents;
+
+	b2Vec2 boxCenter = { width / 2.0f, height / 2.0f };
+	b2Rot rotation = { 1.0f, 0.0f };
+	b2Polygon box = b2MakeOffsetBox(width / 2.0f, height / 2.0f, boxCenter, rotation);
+
+	return b2CreatePolygonShape(bodyId, &shapeDef, &box);
+}
+
+void PhysicsWorld::releaseComponentBody(b2BodyId bodyId, bool isDynamic, bool isBullet, const Vector2D& poolSize,
+	const b2ShapeId shapes[2])
+{
+	if (!isBodyValid(bodyId)) return;
+
+	std::vector<PooledBody>* bucket = nullptr;
+	if (!isArcade(bodyId)) {
+		bucket = &m_bodyPools[poolKey(isDynamic, isBullet, poolSize)];
+	}
+
+	// A disabled body has no proxies to reset the shapes' filters on; it is not kept
+	if (!bucket || static_cast<int>(bucket->size()) >= MAX_POOLED_PER_BUCKET || !b2Body_IsEnabled(bodyId)) {
+		destroyShape(shapes[0]);
+		destroyShape(shapes[1]);
+		destroyBody(bodyId);
+		return;
+	}
+
+	// Shapes are made inert while the body still has its proxies, then the body leaves
+	// the broadphase. Events already queued for them resolve to no component
+	PooledBody pooled = { bodyId, { b2_nullShapeId, b2_nullShapeId } };
+	b2Filter inert = b2DefaultFilter();
+	inert.categoryBits = 0;
+	inert.maskBits = 0;
+	for (int i = 0; i < 2; ++i) {
+		if (!isShapeValid(shapes[i])) continue;
+
+		b2Shape_SetUserData(shapes[i], nullptr);
+		b2Shape_SetFilter(shapes[i], inert);
+		b2Shape_EnableSensorEvents(shapes[i], false);
+		b2Shape_EnableHitEvents(shapes[i], false);
+		pooled.shapes[i] = shapes[i];
+	}
+	b2Body_SetUserData(bodyId, nullptr);
+	b2Body_Disable(bodyId);
+
+	bucket->push_back(pooled);
+	m_poolStats.pooledBodies++;
+}
+
+uint64_t PhysicsWorld::poolKey(bool isDynamic, bool isBullet, const Vector2D& poolSize)
+{
+	uint64_t width = static_cast<uint16_t>(poolSize.x + 0.5f);
+	uint64_t height = static_cast<uint16_t>(poolSize.y + 0.5f);
+	return (width << 32) | (height << 16) | (isBullet ? 2u : 0u) | (isDynamic ? 1u : 0u);
+}
+
+bool PhysicsWorld::isFreshlyArmed(b2BodyId bodyId) const
+{
+	uint32_t index = static_cast<uint32_t>(bodyId.index1);
+	return index < m_bodyArmedStep.size() && m_bodyArmedStep[index] == m_stepCount;
+}
+
+void PhysicsWorld::logPoolStats() const
+{
+	E2_LOG(Log, "Physics body pool: %d hits, %d misses; shapes %d hits, %d misses; %d bodies pooled",
+		m_poolStats.bodyHits, m_poolStats.bodyMisses, m_poolStats.shapeHits, m_poolStats.shapeMisses,
+		m_poolStats.pooledBodies);
+}
+
+void PhysicsWorld::destroyShape(b2ShapeId shapeId)
+{
+	if (isArcade(shapeId)) {
+		if (isShapeValid(shapeId)) m_arcade->destroyShape(shapeId.index1 - 1);
+	}
+	else if (b2Shape_IsValid(shapeId)) {
+		b2DestroyShape(shapeId, false);
+	}
+}
+
+bool PhysicsWorld::isBodyValid(b2BodyId bodyId) const
+{
+	if (isArcade(bodyId)) return m_arcade->isBodyValid(bodyId.index1 - 1, bodyId.revision);
+	return bodyId.world0 != ARCADE_WORLD && b2Body_IsValid(bodyId);
+}
+
+bool PhysicsWorld::isShapeValid(b2ShapeId shapeId) const
+{
+	if (isArcade(shapeId)) return m_arcade->isShapeValid(shapeId.index1 - 1, shapeId.revision);
+	return shapeId.world0 != ARCADE_WORLD && b2Shape_IsValid(shapeId);
+}
+
+void PhysicsWorld::setBodyEnabled(b2BodyId bodyId, bool enabled)
+{
+	if (!isBodyValid(bodyId)) return;
+
+	if (isArcade(bodyId)) {
+		m_arcade->getBody(bodyId.index1 - 1).enabled = enabled;
+		m_arcade->markBodyMoved(bodyId.index1 - 1);
+	}
+	else if (enabled) {
+		b2Body_Enable(bodyId);
+	}
+	else {
+		b2Body_Disable(bodyId);
+	}
+}
+
+bool PhysicsWorld::isBodyEnabled(b2BodyId bodyId) const
+{
+	if (!isBodyValid(bodyId)) return false;
+	if (isArcade(bodyId)) return m_arcade->getBody(bodyId.index1 - 1).enabled;
+	return b2Body_IsEnabled(bodyId);
+}
+
+void PhysicsWorld::setShapeFilter(b2ShapeId shapeId, const b2Filter& filter)
+{
+	if (!isShapeValid(shapeId)) return;
+
+	if (isArcade(shapeId)) {
+		ArcadeWorld::Shape& shape = m_arcade->getShape(shapeId.index1 - 1);
+		shape.categoryBits = filter.categoryBits;
+		shape.maskBits = filter.maskBits;
+	}
+	else {
+		b2Shape_SetFilter(shapeId, filter);
+	}
+}
+
+void PhysicsWorld::enableSensorEvents(b2ShapeId shapeId, bool enable)
+{
+	if (!isShapeValid(shapeId)) return;
+
+	if (isArcade(shapeId)) {
+		m_arcade->getShape(shapeId.index1 - 1).sensorEvents = enable;
+	}
+	else {
+		b2Shape_EnableSensorEvents(shapeId, enable);
+	}
+}
+
+void PhysicsWorld::enableHitEvents(b2ShapeId shapeId, bool enable)
+{
+	if (isShapeValid(shapeId) && !isArcade(shapeId)) {
+		b2Shape_EnableHitEvents(shapeId, enable);
+	}
+}
+
+Vector4D PhysicsWorld::getShapeBounds(b2ShapeId shapeId) const
+{
+	if (!isShapeValid(shapeId)) return Vector4D();
+
+	if (isArcade(shapeId)) {
+		const ArcadeWorld::Shape& shape = m_arcade->getShape(shapeId.index1 - 1);
+		const ArcadeWorld::Body& body = m_arcade->getBody(shape.body);
+		return Vector4D(body.x + shape.offsetX, body.y + shape.offsetY, shape.width, shape.height);
+	}
+
+	b2AABB aabb = b2Shape_GetAABB(shapeId);
+	return Vector4D(aabb.lowerBound.x, aabb.lowerBound.y,
+		aabb.upperBound.x - aabb.lowerBound.x, aabb.upperBound.y - aabb.lowerBound.y);
+}
 
+void PhysicsWorld::syncMovedBodies()
+{
+	// Box2D lists only the bodies that moved this step (sleeping and static ones do not),
+	// so transforms are written here instead of every component polling its body
+	b2BodyEvents bodyEvents = b2World_GetBodyEvents(m_worldId);
+	m_movedBodies = bodyEvents.moveCount;
+
+	for (int i = 0; i < bodyEvents.moveCount; ++i) {
+		const b2BodyMoveEvent& event = bodyEvents.moveEvents[i];
+		PhysicsComponent* component = static_cast<PhysicsComponent*>(event.userData);
+		if (component) {
+			component->getOwner()->getTransform()->setPosition(event.transform.p.x, event.transform.p.y);
+		}
+	}
+}
+
+void PhysicsWorld::syncArcadeBodies()
+{
+	const std::vector<int>& moved = m_arcade->getMovedBodies();
+	m_movedBodies = static_cast<int>(moved.size());
+
+	for (int index : moved) {
+		const ArcadeWorld::Body& body = m_arcade->getBody(index);
+		PhysicsComponent* component = static_cast<PhysicsComponent*>(body.userData);
+		if (component) {
+			component->getOwner()->getTransform()->setPosition(body.x, body.y);
+		}
+	}
+}
+
+PhysicsComponent* PhysicsWorld::componentFromShape(b2ShapeId shapeId) const
+{
+	// End events can name shapes destroyed during the step
+	if (!isShapeValid(shapeId)) return nullptr;
+	if (isArcade(shapeId)) return static_cast<PhysicsComponent*>(m_arcade->getShape(shapeId.index1 - 1).userData);
+	return static_cast<PhysicsComponent*>(b2Shape_GetUserData(shapeId));
+}
+
+void PhysicsWorld::gatherEvents()
+{
+	m_events.clear();
+	m_eventStats = PhysicsEventStats();
+
+	auto add = [this](PhysicsEventType type, b2ShapeId shapeA, b2ShapeId shapeB, float approachSpeed) {
+		PhysicsComponent* a = componentFromShape(shapeA);
+		PhysicsComponent* b = componentFromShape(shapeB);
+		if (!a || !b) {
+			m_eventStats.skipped++;
+			return;
+		}
+		bool isEnd = type == PhysicsEventType::SensorEnd || type == PhysicsEventType::ContactEnd;
+		if (isEnd && (isFreshlyArmed(a->getBodyId()) || isFreshlyArmed(b->getBodyId()))) {
+			m_eventStats.skipped++;
+			return;
+		}
+		m_events.push_back({ type, a->getBodyId().index1, b->getBodyId().index1, a, b, approachSpeed });
+	};
+
+	b2SensorEvents sensorEvents = b2World_GetSensorEvents(m_worldId);
 	for (int i = 0; i < sensorEvents.beginCount; ++i) {
-		const b2SensorBeginTouchEvent* event = sensorEvents.beginEvents + i;
+		const b2SensorBeginTouchEvent& event = sensorEvents.beginEvents[i];
+		add(PhysicsEventType::SensorBegin, event.sensorShapeId, event.visitorShapeId, 0.0f);
+	}
+	for (int i = 0; i < sensorEvents.endCount; ++i) {
+		const b2SensorEndTouchEvent& event = sensorEvents.endEvents[i];
+		add(PhysicsEventType::SensorEnd, event.sensorShapeId, event.visitorShapeId, 0.0f);
+	}
 
-// 		E2_LOG(Warning, "Processing event with shapes: %d and %d",
-// 			event->sensorShapeId.index1,
-// 			event->visitorShapeId.index1);
+	b2ContactEvents contactEvents = b2World_GetContactEvents(m_worldId);
+	for (int i = 0; i < contactEvents.beginCount; ++i) {
+		const b2ContactBeginTouchEvent& event = contactEvents.beginEvents[i];
+		add(PhysicsEventType::ContactBegin, event.shapeIdA, event.shapeIdB, 0.0f);
+	}
+	for (int i = 0; i < contactEvents.endCount; ++i) {
+		const b2ContactEndTouchEvent& event = contactEvents.endEvents[i];
+		add(PhysicsEventType::ContactEnd, event.shapeIdA, event.shapeIdB, 0.0f);
+	}
+	for (int i = 0; i < contactEvents.hitCount; ++i) {
+		const b2ContactHitEvent& event = contactEvents.hitEvents[i];
+		add(PhysicsEventType::Hit, event.shapeIdA, event.shapeIdB, event.approachSpeed);
+	}
 
-		PhysicsComponent* sensorComponent = static_cast<PhysicsComponent*>(
-			b2Body_GetUserData(b2Shape_GetBody(event->sensorShapeId)));
-		PhysicsComponent* visitorComponent = static_cast<PhysicsComponent*>(
-			b2Body_GetUserData(b2Shape_GetBody(event->visitorShapeId)));
+	std::sort(m_events.begin(), m_events.end(), [](const PhysicsEvent& x, const PhysicsEvent& y) {
+		if (x.type != y.type) return x.type < y.type;
+		if (x.keyA != y.keyA) return x.keyA < y.keyA;
+		return x.keyB < y.keyB;
+	});
 
-		if (sensorComponent && visitorComponent) {
-// 			E2_LOG(Warning, "Found components, layers: %s and %s",
-// 				sensorComponent->getLayer().c_str(),
-// 				visitorComponent->getLayer().c_str());
+	// Several shapes of the same two bodies report the same pair
+	auto last = std::unique(m_events.begin(), m_events.end(), [](const PhysicsEvent& x, const PhysicsEvent& y) {
+		return x.type == y.type && x.a == y.a && x.b == y.b;
+	});
+	m_eventStats.duplicates = static_cast<int>(m_events.end() - last);
+	m_events.erase(last, m_events.end());
+}
 
-			sensorComponent->handleSensorBegin(visitorComponent->getOwner());
-			visitorComponent->handleSensorBegin(sensorComponent->getOwner());
+void PhysicsWorld::gatherArcadeEvents()
+{
+	m_events.clear();
+	m_eventStats = PhysicsEventStats();
+
+	// Already sorted by pair and free of duplicates; the order by type and body below
+	// matches the Box2D path
+	for (const ArcadeWorld::PairEvent& pair : m_arcade->getPairEvents()) {
+		const ArcadeWorld::Shape& shapeA = m_arcade->getShape(pair.shapeA);
+		const ArcadeWorld::Shape& shapeB = m_arcade->getShape(pair.shapeB);
+		PhysicsComponent* a = static_cast<PhysicsComponent*>(shapeA.userData);
+		PhysicsComponent* b = static_cast<PhysicsComponent*>(shapeB.userData);
+		if (!a || !b) {
+			m_eventStats.skipped++;
+			continue;
+		}
+
+		PhysicsEventType type = pair.isSensor
+			? (pair.begin ? PhysicsEventType::SensorBegin : PhysicsEventType::SensorEnd)
+			: (pair.begin ? PhysicsEventType::ContactBegin : PhysicsEventType::ContactEnd);
+		m_events.push_back({ type, shapeA.body, shapeB.body, a, b, 0.0f });
+	}
+
+	std::sort(m_events.begin(), m_events.end(), [](const PhysicsEvent& x, const PhysicsEvent& y) {
+		if (x.type != y.type) return x.type < y.type;
+		if (x.keyA != y.keyA) return x.keyA < y.keyA;
+		return x.keyB < y.keyB;
+	});
+}
+
+void PhysicsWorld::dispatchEvents()
+{
+	for (const PhysicsEvent& event : m_events) {
+		GameObject* ownerA = event.a->getOwner();
+		GameObject* ownerB = event.b->getOwner();
+
+		// An earlier callback in this pass may have removed one of them (a projectile
+		// that already hit something); begin events for it are dropped, ends still go out
+		bool removed = ownerA->isPendingRemoval() || ownerB->isPendingRemoval();
+
+		switch (event.type) {
+		case PhysicsEventType::SensorBegin:
+			if (removed) { m_eventStats.skipped++; continue; }
+			m_eventStats.sensorBegin++;
+			event.a->handleSensorBegin(ownerB);
+			event.b->handleSensorBegin(ownerA);
+			break;
+		case PhysicsEventType::SensorEnd:
+			m_eventStats.sensorEnd++;
+			event.a->handleSensorEnd(ownerB);
+			event.b->handleSensorEnd(ownerA);
+			break;
+		case PhysicsEventType::ContactBegin:
+			if (removed) { m_eventStats.skipped++; continue; }
+			m_eventStats.contactBegin++;
+			event.a->handleContactBegin(ownerB);
+			event.b->handleContactBegin(ownerA);
+			break;
+		case PhysicsEventType::ContactEnd:
+			m_eventStats.contactEnd++;
+			event.a->handleContactEnd(ownerB);
+			event.b->handleContactEnd(ownerA);
+			break;
+		case PhysicsEventType::Hit:
+			if (removed) { m_eventStats.skipped++; continue; }
+			m_eventStats.hits++;
+			event.a->handleHit(ownerB, event.approachSpeed);
+			event.b->handleHit(ownerA, event.approachSpeed);
+			break;
+		}
+	}
+}
+
+void PhysicsWorld::addBoundsVolume(ScreenBoundsComponent* component)
+{
+	if (component->m_volumeSlot >= 0) return;
+
+	// Starts inside, so an object spawned off screen exits on the first pass
+	component->m_volumeSlot = static_cast<int>(m_boundsVolumes.size());
+	m_boundsVolumes.push_back({ 0.0f, 0.0f, 0.0f, 0.0f, component->getOwner()->getTransform(), component, false });
+	refreshBoundsVolume(component);
+}
+
+void PhysicsWorld::removeBoundsVolume(ScreenBoundsComponent* component)
+{
+	int slot = component->m_volumeSlot;
+	if (slot < 0) return;
+
+	m_boundsVolumes[slot] = m_boundsVolumes.back();
+	m_boundsVolumes[slot].component->m_volumeSlot = slot;
+	m_boundsVolumes.pop_back();
+	component->m_volumeSlot = -1;
+}
+
+void PhysicsWorld::refreshBoundsVolume(ScreenBoundsComponent* component)
+{
+	if (component->m_volumeSlot < 0) return;
+
+	Vector4D region = component->getInBoundsRegion();
+	BoundsVolume& volume = m_boundsVolumes[component->m_volumeSlot];
+	volume.minX = region.x;
+	volume.minY = region.y;
+	volume.maxX = region.getRight();
+	volume.maxY = region.getBottom();
+}
+
+void PhysicsWorld::updateBounds()
+{
+	E2_PROFILE_SCOPE("PhysicsWorld::updateBounds");
+
+	m_boundsEvents.clear();
+	for (BoundsVolume& volume : m_boundsVolumes) {
+		const Vector2D& pos = volume.transform->getPosition();
+		bool outside = pos.x < volume.minX || pos.x > volume.maxX || pos.y < volume.minY || pos.y > volume.maxY;
+		if (outside == volume.outside) continue;
+
+		// Removed objects are done with; dormant ones are not watched unless bounds put them
+		// to sleep. Their state is left as is, so the change is seen once they are back
+		GameObject* owner = volume.component->getOwner();
+		if (owner->isPendingRemoval() || (owner->isDormant() && !volume.component->m_isSleeping)) continue;
+
+		volume.outside = outside;
+		m_boundsEvents.push_back({ volume.component, outside });
+	}
+
+	// Handlers may remove, put to sleep or wake objects; none of that touches the volumes
+	for (const BoundsEvent& event : m_boundsEvents) {
+		if (event.exited) {
+			event.component->onExit();
 		}
 		else {
-			E2_LOG(Warning, "Failed to get components from bodies");
+			event.component->onEnter();
 		}
 	}
-}
\ No newline at end of file
+}
+
+
+namespace
+{
+	// Closest point of the bounds to p, p itself when inside
+	float distanceToBounds(const Vector4D& bounds, const Vector2D& p, Vector2D& closest)
+	{
+		closest.x = std::min(std::max(p.x, bounds.x), bounds.getRight());
+		closest.y = std::min(std::max(p.y, bounds.y), bounds.getBottom());
+		float dx = closest.x - p.x;
+		float dy = closest.y - p.y;
+		return std::sqrt(dx * dx + dy * dy);
+	}
+
+	// A box with the given half extents moving from centre by translation, against the
+	// bounds grown by those extents. False if it misses or starts overlapping them
+	bool castAgainst(const Vector4D& bounds, const Vector2D& centre, float halfWidth, float halfHeight,
+		const Vector2D& translation, float& fraction, Vector2D& normal)
+	{
+		const float minimum[2] = { bounds.x - halfWidth, bounds.y - halfHeight };
+		const float maximum[2] = { bounds.getRight() + halfWidth, bounds.getBottom() + halfHeight };
+		const float origin[2] = { centre.x, centre.y };
+		const float delta[2] = { translation.x, translation.y };
+
+		float enter = 0.0f;
+		float exit = 1.0f;
+		int enterAxis = -1;
+		float enterSign = 0.0f;
+		for (int axis = 0; axis < 2; ++axis) {
+			if (std::fabs(delta[axis]) < 1e-6f) {
+				if (origin[axis] < minimum[axis] || origin[axis] > maximum[axis]) return false;
+				continue;
+			}
+
+			float inverse = 1.0f / delta[axis];
+			float first = (minimum[axis] - origin[axis]) * inverse;
+			float last = (maximum[axis] - origin[axis]) * inverse;
+			float sign = -1.0f;
+			if (first > last) {
+				std::swap(first, last);
+				sign = 1.0f;
+			}
+			if (first > enter) {
+				enter = first;
+				enterAxis = axis;
+				enterSign = sign;
+			}
+			exit = std::min(exit, last);
+			if (enter > exit) return false;
+		}
+
+		if (enterAxis < 0) return false;
+		fraction = enter;
+		normal = enterAxis == 0 ? Vector2D(enterSign, 0.0f) : Vector2D(0.0f, enterSign);
+		return true;
+	}
+}
+
+template <typename Visit>
+void PhysicsWorld::forEachShapeIn(float minX, float minY, float maxX, float maxY, uint64_t maskBits, Visit&& visit) const
+{
+	if (m_arcade) {
+		struct ArcadeContext
+		{
+			const ArcadeWorld* arcade;
+			Visit* visit;
+			float minX, minY, maxX, maxY;
+			uint64_t maskBits;
+		};
+		ArcadeContext context = { m_arcade, &visit, minX, minY, maxX, maxY, maskBits };
+
+		// The arcade grid hands out shapes from the cells the rectangle covers
+		m_arcade->queryBox(minX, minY, maxX, maxY, [](int index, void* userContext) -> bool {
+			ArcadeContext& context = *static_cast<ArcadeContext*>(userContext);
+			const ArcadeWorld::Shape& shape = context.arcade->getShape(index);
+			if (!shape.alive || !shape.userData || (shape.categoryBits & context.maskBits) == 0) return true;
+
+			const ArcadeWorld::Body& body = context.arcade->getBody(shape.body);
+			if (!body.enabled) return true;
+
+			Vector4D bounds(body.x + shape.offsetX, body.y + shape.offsetY, shape.width, shape.height);
+			if (bounds.x > context.maxX || bounds.getRight() < context.minX ||
+				bounds.y > context.maxY || bounds.getBottom() < context.minY) return true;
+
+			b2ShapeId shapeId = { index + 1, ARCADE_WORLD, shape.generation };
+			return (*context.visit)(shapeId, static_cast<PhysicsComponent*>(shape.userData), bounds);
+		}, &context);
+		return;
+	}
+
+	if (!b2World_IsValid(m_worldId)) return;
+
+	struct Context
+	{
+		Visit* visit;
+		b2AABB box;
+	};
+	Context context = { &visit, { { minX, minY }, { maxX, maxY } } };
+
+	// Box2D reports shapes whose enlarged tree bounds overlap; their own bounds decide.
+	// Every category is offered so the shape's mask does not hide it from the query
+	b2QueryFilter filter = { UINT64_MAX, maskBits };
+	b2World_OverlapAABB(m_worldId, context.box, filter, [](b2ShapeId shapeId, void* userContext) -> bool {
+		Context& context = *static_cast<Context*>(userContext);
+		PhysicsComponent* component = static_cast<PhysicsComponent*>(b2Shape_GetUserData(shapeId));
+		if (!component) return true;
+
+		b2AABB aabb = b2Shape_GetAABB(shapeId);
+		if (aabb.lowerBound.x > context.box.upperBound.x || aabb.upperBound.x < context.box.lowerBound.x ||
+			aabb.lowerBound.y > context.box.upperBound.y || aabb.upperBound.y < context.box.lowerBound.y) return true;
+
+		Vector4D bounds(aabb.lowerBound.x, aabb.lowerBound.y,
+			aabb.upperBound.x - aabb.lowerBound.x, aabb.upperBound.y - aabb.lowerBound.y);
+		return (*context.visit)(shapeId, component, bounds);
+	}, &context);
+}
+
+int PhysicsWorld::overlapAABB(const Vector4D& rect, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const
+{
+	int count = 0;
+	if (capacity <= 0) return 0;
+
+	forEachShapeIn(rect.x, rect.y, rect.getRight(), rect.getBottom(), maskBits,
+		[&](b2ShapeId shapeId, PhysicsComponent* component, const Vector4D&) {
+			hits[count++] = { component, shapeId, Vector2D(), Vector2D(), 0.0f, 0.0f };
+			return count < capacity;
+		});
+	return count;
+}
+
+int PhysicsWorld::overlapCircle(const Vector2D& center, float radius, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const
+{
+	int count = 0;
+	if (capacity <= 0) return 0;
+
+	forEachShapeIn(center.x - radius, center.y - radius, center.x + radius, center.y + radius, maskBits,
+		[&](b2ShapeId shapeId, PhysicsComponent* component, const Vector4D& bounds) {
+			Vector2D closest;
+			float distance = distanceToBounds(bounds, center, closest);
+			if (distance > radius) return true;
+
+			hits[count++] = { component, shapeId, closest, Vector2D(), 0.0f, distance };
+			return count < capacity;
+		});
+	return count;
+}
+
+int PhysicsWorld::findNearest(const Vector2D& point, float maxDistance, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const
+{
+	int count = 0;
+	if (capacity <= 0) return 0;
+
+	// Kept sorted in the caller's array; a full array only takes hits closer than its last
+	forEachShapeIn(point.x - maxDistance, point.y - maxDistance, point.x + maxDistance, point.y + maxDistance, maskBits,
+		[&](b2ShapeId shapeId, PhysicsComponent* component, const Vector4D& bounds) {
+			Vector2D closest;
+			float distance = distanceToBounds(bounds, point, closest);
+			if (distance > maxDistance) return true;
+			if (count == capacity && distance >= hits[count - 1].distance) return true;
+
+			int slot = count < capacity ? count++ : capacity - 1;
+			while (slot > 0 && hits[slot - 1].distance > distance) {
+				hits[slot] = hits[slot - 1];
+				--slot;
+			}
+			hits[slot] = { component, shapeId, closest, Vector2D(), 0.0f, distance };
+			return true;
+		});
+	return count;
+}
+
+bool PhysicsWorld::rayCast(const Vector2D& origin, const Vector2D& translation, uint64_t maskBits, PhysicsQueryHit& hit) const
+{
+	hit = PhysicsQueryHit();
+	hit.fraction = 1.0f;
+
+	if (!m_arcade) {
+		if (!b2World_IsValid(m_worldId)) return false;
+
+		// Returning the fraction clips the ray, so the last shape reported is the closest
+		b2QueryFilter filter = { UINT64_MAX, maskBits };
+		b2World_CastRay(m_worldId, { origin.x, origin.y }, { translation.x, translation.y }, filter,
+			[](b2ShapeId shapeId, b2Vec2 point, b2Vec2 normal, float fraction, void* context) -> float {
+				PhysicsComponent* component = static_cast<PhysicsComponent*>(b2Shape_GetUserData(shapeId));
+				if (!component) return -1.0f;
+
+				PhysicsQueryHit& hit = *static_cast<PhysicsQueryHit*>(context);
+				hit = { component, shapeId, { point.x, point.y }, { normal.x, normal.y }, fraction, 0.0f };
+				return fraction;
+			}, &hit);
+		return hit.component != nullptr;
+	}
+
+	Vector2D end(origin.x + translation.x, origin.y + translation.y);
+	forEachShapeIn(std::min(origin.x, end.x), std::min(origin.y, end.y), std::max(origin.x, end.x), std::max(origin.y, end.y), maskBits,
+		[&](b2ShapeId shapeId, PhysicsComponent* component, const Vector4D& bounds) {
+			float fraction;
+			Vector2D normal;
+			if (castAgainst(bounds, origin, 0.0f, 0.0f, translation, fraction, normal) && fraction < hit.fraction) {
+				Vector2D point(origin.x + translation.x * fraction, origin.y + translation.y * fraction);
+				hit = { component, shapeId, point, normal, fraction, 0.0f };
+			}
+			return true;
+		});
+	return hit.component != nullptr;
+}
+
+bool PhysicsWorld::boxCast(const Vector4D& box, const Vector2D& translation, uint64_t maskBits, PhysicsQueryHit& hit) const
+{
+	hit = PhysicsQueryHit();
+	hit.fraction = 1.0f;
+
+	// Component shapes never rotate, so a box cast is a ray from the box's centre
+	// against each candidate grown by the box's half size
+	const float halfWidth = box.w * 0.5f;
+	const float halfHeight = box.h * 0.5f;
+	const Vector2D centre(box.x + halfWidth, box.y + halfHeight);
+	const float minX = std::min(box.x, box.x + translation.x);
+	const float minY = std::min(box.y, box.y + translation.y);
+	const float maxX = std::max(box.getRight(), box.getRight() + translation.x);
+	const float maxY = std::max(box.getBottom(), box.getBottom() + translation.y);
+
+	forEachShapeIn(minX, minY, maxX, maxY, maskBits,
+		[&](b2ShapeId shapeId, PhysicsComponent* component, const Vector4D& bounds) {
+			float fraction;
+			Vector2D normal;
+			if (castAgainst(bounds, centre, halfWidth, halfHeight, translation, fraction, normal) && fraction < hit.fraction) {
+				// Where the moving box's leading face meets the shape
+				Vector2D point(centre.x + translation.x * fraction - normal.x * halfWidth,
+					centre.y + translation.y * fraction - normal.y * halfHeight);
+				hit = { component, shapeId, point, normal, fraction, 0.0f };
+			}
+			return true;
+		});
+	return hit.component != nullptr;
+}
+
+void PhysicsWorld::runQueries(PhysicsQuery* queries, int count) const
+{
+	E2_PROFILE_SCOPE("PhysicsWorld::runQueries");
+
+	JobSystem::Instance().parallelFor(count, 16, [this, queries](int begin, int end) {
+		for (int i = begin; i < end; ++i) {
+			PhysicsQuery& query = queries[i];
+			switch (query.type) {
+			case PhysicsQueryType::OverlapAABB:
+				query.hitCount = overlapAABB(query.rect, query.maskBits, query.hits, query.capacity);
+				break;
+			case PhysicsQueryType::OverlapCircle:
+				query.hitCount = overlapCircle(query.point, query.radius, query.maskBits, query.hits, query.capacity);
+				break;
+			case PhysicsQueryType::Nearest:
+				query.hitCount = findNearest(query.point, query.radius, query.maskBits, query.hits, query.capacity);
+				break;
+			case PhysicsQueryType::RayCast:
+				query.hitCount = query.capacity > 0 && rayCast(query.point, query.translation, query.maskBits, query.hits[0]) ? 1 : 0;
+				break;
+			case PhysicsQueryType::BoxCast:
+				query.hitCount = query.capacity > 0 && boxCast(query.rect, query.translation, query.maskBits, query.hits[0]) ? 1 : 0;
+				break;
+			}
+		}
+	});
+}
+
+void PhysicsWorld::recordStepStats(float arcadeStepMs)
+{
+	PhysicsStepSample& sample = m_statsHistory[m_statsNext];
+	sample = PhysicsStepSample();
+	sample.events = static_cast<int>(m_events.size());
+
+	if (m_arcade) {
+		sample.stepMs = arcadeStepMs;
+		sample.bodies = m_arcade->getBodyCount();
+		sample.shapes = m_arcade->getShapeCount();
+		sample.contacts = m_arcade->getPairCount();
+		sample.tasks = 1;
+	}
+	else {
+		b2Profile profile = b2World_GetProfile(m_worldId);
+		b2Counters counters = b2World_GetCounters(m_worldId);
+		sample.stepMs = profile.step;
+		sample.pairsMs = profile.pairs;
+		sample.collideMs = profile.collide;
+		sample.solveMs = profile.solve;
+		sample.bodies = counters.bodyCount;
+		sample.shapes = counters.shapeCount;
+		sample.contacts = counters.contactCount;
+		sample.islands = counters.islandCount;
+		sample.tasks = counters.taskCount;
+	}
+
+	m_statsNext = (m_statsNext + 1) % STATS_HISTORY;
+	if (m_statsCount < STATS_HISTORY) m_statsCount++;
+}
+
+const PhysicsStepSample& PhysicsWorld::getStatsSample(int age) const
+{
+	static const PhysicsStepSample empty;
+	if (age < 0 || age >= m_statsCount) return empty;
+	return m_statsHistory[(m_statsNext - 1 - age + STATS_HISTORY) % STATS_HISTORY];
+}
+
+PhysicsStatsSummary PhysicsWorld::getStatsSummary() const
+{
+	PhysicsStatsSummary summary;
+	summary.samples = m_statsCount;
+	if (m_statsCount == 0) return summary;
+
+	auto add = [](PhysicsStatRange& range, float value, bool first) {
+		range.min = first ? value : std::min(range.min, value);
+		range.max = first ? value : std::max(range.max, value);
+		range.avg += value;
+	};
+	for (int age = 0; age < m_statsCount; ++age) {
+		const PhysicsStepSample& sample = getStatsSample(age);
+		bool first = age == 0;
+		add(summary.stepMs, sample.stepMs, first);
+		add(summary.pairsMs, sample.pairsMs, first);
+		add(summary.collideMs, sample.collideMs, first);
+		add(summary.solveMs, sample.solveMs, first);
+		add(summary.bodies, static_cast<float>(sample.bodies), first);
+		add(summary.shapes, static_cast<float>(sample.shapes), first);
+		add(summary.contacts, static_cast<float>(sample.contacts), first);
+		add(summary.tasks, static_cast<float>(sample.tasks), first);
+	}
+
+	const float scale = 1.0f / m_statsCount;
+	for (PhysicsStatRange* range : { &summary.stepMs, &summary.pairsMs, &summary.collideMs, &summary.solveMs,
+		&summary.bodies, &summary.shapes, &summary.contacts, &summary.tasks }) {
+		range->avg *= scale;
+	}
+	return summary;
+}
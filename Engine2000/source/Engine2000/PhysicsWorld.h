@@ -2,14 +2,162 @@
 
 #include "Core.h"
 #include "Vector2D.h"
+#include "Vector4D.h"
+#include "JobSystem.h"
+#include "PhysicsBackend.h"
 #include <box2d/box2d.h>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 #include "SDL2/SDL_pixels.h"
 
+class PhysicsComponent;
+class ScreenBoundsComponent;
+class ArcadeWorld;
+class TransformComponent;
+
+// In dispatch order: an object that leaves and re-enters in one step ends before it begins
+enum class PhysicsEventType : uint8_t
+{
+    SensorEnd,
+    ContactEnd,
+    SensorBegin,
+    ContactBegin,
+    Hit
+};
+
+// One Box2D event, resolved to the components involved. Keys are body indices, which
+// are stable for a given run, so the sorted order replays identically
+struct PhysicsEvent
+{
+    PhysicsEventType type;
+    int keyA;
+    int keyB;
+    PhysicsComponent* a;    // Sensor for sensor events
+    PhysicsComponent* b;    // Visitor for sensor events
+    float approachSpeed;    // Hit events only
+};
+
+// A ScreenBoundsComponent's in-bounds rectangle for its owner's position, tested in
+// one pass over a flat array by PhysicsWorld::updateBounds
+struct BoundsVolume
+{
+    float minX, minY, maxX, maxY;
+    TransformComponent* transform;
+    ScreenBoundsComponent* component;
+    bool outside;
+};
+
+struct BoundsEvent
+{
+    ScreenBoundsComponent* component;
+    bool exited;
+};
+
+// One shape found by a spatial query. Casts fill point, normal and fraction (of the
+// translation, 0..1); circle and nearest queries fill point, the closest on the shape,
+// and distance to it; overlapAABB fills only the shape and component
+struct PhysicsQueryHit
+{
+    PhysicsComponent* component;
+    b2ShapeId shapeId;
+    Vector2D point;
+    Vector2D normal;
+    float fraction;
+    float distance;
+};
+
+enum class PhysicsQueryType : uint8_t
+{
+    OverlapAABB,
+    OverlapCircle,
+    Nearest,
+    RayCast,
+    BoxCast
+};
+
+// A query for PhysicsWorld::runQueries; fields not used by its type are ignored
+struct PhysicsQuery
+{
+    PhysicsQueryType type = PhysicsQueryType::OverlapAABB;
+    Vector4D rect;              // OverlapAABB, BoxCast: x, y, w, h
+    Vector2D point;             // OverlapCircle, Nearest: centre; RayCast: origin
+    Vector2D translation;       // RayCast, BoxCast
+    float radius = 0.0f;        // OverlapCircle; Nearest: max distance
+    uint64_t maskBits = 0;
+    PhysicsQueryHit* hits = nullptr;
+    int capacity = 0;
+    int hitCount = 0;           // Written by runQueries
+};
+
+// Counted for the last step
+struct PhysicsEventStats
+{
+    int sensorBegin = 0;
+    int sensorEnd = 0;
+    int contactBegin = 0;
+    int contactEnd = 0;
+    int hits = 0;
+    int duplicates = 0;     // Same pair and type reported more than once
+    int skipped = 0;        // Destroyed shapes, shapes without a component, removed objects
+};
+
+// One step's Box2D profile, in milliseconds, and counters. The arcade backend times its
+// own step and counts its pairs as contacts; it has no pairs/collide/solve breakdown
+struct PhysicsStepSample
+{
+    float stepMs = 0.0f;
+    float pairsMs = 0.0f;
+    float collideMs = 0.0f;
+    float solveMs = 0.0f;
+    int bodies = 0;
+    int shapes = 0;
+    int contacts = 0;
+    int islands = 0;
+    int tasks = 0;
+    int events = 0;         // Dispatched after the step
+};
+
+struct PhysicsStatRange
+{
+    float min = 0.0f;
+    float avg = 0.0f;
+    float max = 0.0f;
+};
+
+// Over the steps in PhysicsWorld's history
+struct PhysicsStatsSummary
+{
+    PhysicsStatRange stepMs;
+    PhysicsStatRange pairsMs;
+    PhysicsStatRange collideMs;
+    PhysicsStatRange solveMs;
+    PhysicsStatRange bodies;
+    PhysicsStatRange shapes;
+    PhysicsStatRange contacts;
+    PhysicsStatRange tasks;
+    int samples = 0;
+};
+
+// Component bodies taken from and returned to the pools since init
+struct PhysicsPoolStats
+{
+    int bodyHits = 0;
+    int bodyMisses = 0;
+    int shapeHits = 0;      // Shapes re-armed from a pooled body
+    int shapeMisses = 0;    // Created, or replaced a pooled one of another size
+    int pooledBodies = 0;   // Disabled and waiting now
+};
+
 class ENGINE2000_API PhysicsWorld 
 {
 private:
     static const float VELOCITY_SCALE;
+    static const float TIME_SCALE;
+    PhysicsBackend m_backend;
     b2WorldId m_worldId;
+    ArcadeWorld* m_arcade;      // Only with PhysicsBackend::Arcade; ids then carry ARCADE_WORLD
     float m_timeStep;
     int m_subSteps;
     float m_worldWidth;
@@ -17,37 +165,168 @@ private:
     Vector2D m_gravity;
     bool m_debugDraw;
 
-    static bool filterCallback(b2ShapeId shapeIdA, b2ShapeId shapeIdB, void* context);
+    // Box2D tasks run on the engine's job system. The solver enqueues one task per worker
+    // and the other stages a few each, so the counters are sized from the worker count;
+    // a deque grows without moving the counters already handed to Box2D this step
+    static const int FIXED_STEP_TASKS = 16;
+    int m_workerCount;
+    int m_taskCount;
+    std::deque<JobCounter> m_taskCounters;
+
+    // Gathered after each step, dispatched in one pass; reused so it does not reallocate
+    std::vector<PhysicsEvent> m_events;
+    PhysicsEventStats m_eventStats;
+    int m_movedBodies;
+
+    // Screen bounds, swap-removed; events are gathered over the whole pass, then dispatched
+    std::vector<BoundsVolume> m_boundsVolumes;
+    std::vector<BoundsEvent> m_boundsEvents;
+
+    // world0 of arcade body and shape ids; Box2D never has that many worlds
+    static const uint16_t ARCADE_WORLD = 0xFFFF;
+
+    // Released component bodies, disabled with their shapes kept on them, by poolKey
+    struct PooledBody
+    {
+        b2BodyId bodyId;
+        b2ShapeId shapes[2];    // Collision, sensor; null if the component had none
+    };
+    static const int MAX_POOLED_PER_BUCKET = 64;
+    std::unordered_map<uint64_t, std::vector<PooledBody>> m_bodyPools;
+    PhysicsPoolStats m_poolStats;
+
+    // A re-armed body keeps its ids, so end events for its previous owner can come out
+    // of its first step; those are dropped. Indexed by body index1
+    uint32_t m_stepCount;
+    std::vector<uint32_t> m_bodyArmedStep;
+
+    // Ring buffer of the latest STATS_HISTORY steps, for the summary, overlay and stats file
+    std::vector<PhysicsStepSample> m_statsHistory;
+    int m_statsNext;
+    int m_statsCount;
+
+    static void* enqueueTask(b2TaskCallback* task, int32_t itemCount, int32_t minRange, void* taskContext, void* userContext);
+    static void finishTask(void* userTask, void* userContext);
 
 public:
+    static const int STATS_HISTORY = 240;
+
     PhysicsWorld();
     ~PhysicsWorld();
 
-    void init(float worldWidth, float worldHeight, const Vector2D& gravity);
+    // threadCount 0 uses every job system thread (workers + main), 1 steps single-threaded.
+    // Arcade runs on the main thread and ignores gravity (see ArcadeWorld)
+    void init(float worldWidth, float worldHeight, const Vector2D& gravity, int threadCount = 0,
+        PhysicsBackend backend = PhysicsBackend::Box2D);
     void cleanup();
-    void update();
+    void update(float deltaTime);
+
+    PhysicsBackend getBackend() const { return m_backend; }
 
     // Body and shape creation
 	b2BodyId createBody(const Vector2D& position, bool isDynamic, bool isBullet = false);
-	b2ShapeId createBoxShape(b2BodyId bodyId, float width, float height, float density = 1.0f);
+	// Centred on the body; a sensor box reports sensor events from the start
+	b2ShapeId createBoxShape(b2BodyId bodyId, float width, float height, float density = 1.0f, bool isSensor = false);
     void destroyBody(b2BodyId bodyId);
 
+    // What PhysicsComponent builds on; every Box2D call it makes goes through here so
+    // that both backends serve it. Component bodies are kinematic unless dynamic, with
+    // no gravity, damping or rotation; component shapes are boxes from the body origin.
+    // Box2D component bodies are pooled by type, bullet flag and size (the owner's sprite
+    // frame): a pooled body is re-armed with b2Body_Enable and a new transform, and hands
+    // back the shapes left on it as spares for createComponentShape
+    b2BodyId createComponentBody(PhysicsComponent* component, const Vector2D& position, bool isDynamic, bool isBullet,
+        const Vector2D& poolSize, b2ShapeId spareShapes[2]);
+    // Re-arms spare with the new filter data if it is the same kind and size, else destroys
+    // it and creates the shape; spare is cleared either way
+    b2ShapeId createComponentShape(PhysicsComponent* component, float width, float height, bool isSensor,
+        const b2Filter& filter, bool hitEvents, b2ShapeId& spare);
+    // Disables the body and keeps it with shapes (collision, sensor) for the next component
+    // of its kind; destroys them if that bucket is full or the world is arcade
+    void releaseComponentBody(b2BodyId bodyId, bool isDynamic, bool isBullet, const Vector2D& poolSize,
+        const b2ShapeId shapes[2]);
+    void destroyShape(b2ShapeId shapeId);
+    bool isBodyValid(b2BodyId bodyId) const;
+    bool isShapeValid(b2ShapeId shapeId) const;
+    void setBodyEnabled(b2BodyId bodyId, bool enabled);
+    bool isBodyEnabled(b2BodyId bodyId) const;
+    void setShapeFilter(b2ShapeId shapeId, const b2Filter& filter);
+    void enableSensorEvents(b2ShapeId shapeId, bool enable);
+    void enableHitEvents(b2ShapeId shapeId, bool enable);   // Box2D only; arcade shapes never hit
+    Vector4D getShapeBounds(b2ShapeId shapeId) const;       // x, y, w, h
+
     // Body manipulation
     Vector2D getBodyPosition(b2BodyId bodyId);
-    Vector2D getBodyVelocity(b2BodyId bodyId);
+    Vector2D getBodyVelocity(b2BodyId bodyId);              // As stored, VELOCITY_SCALE applied
     void setBodyPosition(b2BodyId bodyId, const Vector2D& position);
     void setBodyVelocity(b2BodyId bodyId, const Vector2D& velocity);
+    // Takes a velocity from getBodyVelocity back as it was
+    void restoreBodyVelocity(b2BodyId bodyId, const Vector2D& velocity);
     
     // Gravity control
     void setGravity(const Vector2D& gravity);
     const Vector2D& getGravity() const { return m_gravity; }
 
+    // Box2D time advanced by the last update
     float getTimeStep() const { return m_timeStep; }
     
-    b2WorldId getWorldId() { return m_worldId; }
+    b2WorldId getWorldId() { return m_worldId; }     // Null with the arcade backend
+    const ArcadeWorld* getArcadeWorld() const { return m_arcade; }
+    int getWorkerCount() const { return m_workerCount; }
+    const PhysicsEventStats& getEventStats() const { return m_eventStats; }
+    const PhysicsPoolStats& getPoolStats() const { return m_poolStats; }
+    // Per-step profile and counters; age 0 is the last step, up to getStatsSampleCount() - 1
+    int getStatsSampleCount() const { return m_statsCount; }
+    const PhysicsStepSample& getStatsSample(int age) const;
+    PhysicsStatsSummary getStatsSummary() const;
+    void logPoolStats() const;
+    // Bodies whose transforms were written back after the last step
+    int getMovedBodyCount() const { return m_movedBodies; }
 
     static float getVelocityScale() { return VELOCITY_SCALE; }
 
+    // Screen bounds volumes; Level adds and removes them as objects enter and leave it
+    void addBoundsVolume(ScreenBoundsComponent* component);
+    void removeBoundsVolume(ScreenBoundsComponent* component);
+    // After the component's flags, margin or sprite size change
+    void refreshBoundsVolume(ScreenBoundsComponent* component);
+    // Tests every volume and tells components that left or re-entered the screen
+    void updateBounds();
+    int getBoundsVolumeCount() const { return static_cast<int>(m_boundsVolumes.size()); }
+    // Exits and re-entries found by the last updateBounds
+    int getBoundsEventCount() const { return static_cast<int>(m_boundsEvents.size()); }
+
+    // Spatial queries in world units. maskBits picks PhysicsLayerManager layers (bit i is
+    // layer i, add SENSOR_CATEGORY for sensors); only component shapes on enabled bodies
+    // are found. Hits go into the caller's array, up to capacity, and the count written is
+    // returned. Any number of threads may query at once, but not while the world steps
+    int overlapAABB(const Vector4D& rect, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const;
+    int overlapCircle(const Vector2D& center, float radius, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const;
+    // The closest shapes within maxDistance, nearest first
+    int findNearest(const Vector2D& point, float maxDistance, uint64_t maskBits, PhysicsQueryHit* hits, int capacity) const;
+    // The first shape hit moving from origin by translation; shapes containing origin are skipped
+    bool rayCast(const Vector2D& origin, const Vector2D& translation, uint64_t maskBits, PhysicsQueryHit& hit) const;
+    // The first shape an axis-aligned box (x, y, w, h) touches moving by translation;
+    // shapes it already overlaps are skipped
+    bool boxCast(const Vector4D& box, const Vector2D& translation, uint64_t maskBits, PhysicsQueryHit& hit) const;
+    // Runs each query into its own hits array, spread over the job system
+    void runQueries(PhysicsQuery* queries, int count) const;
+
 private:
-    void processSensors();
+    bool isArcade(b2BodyId bodyId) const { return m_arcade && bodyId.world0 == ARCADE_WORLD; }
+    bool isArcade(b2ShapeId shapeId) const { return m_arcade && shapeId.world0 == ARCADE_WORLD; }
+    PhysicsComponent* componentFromShape(b2ShapeId shapeId) const;
+    static uint64_t poolKey(bool isDynamic, bool isBullet, const Vector2D& poolSize);
+    bool isFreshlyArmed(b2BodyId bodyId) const;
+    // Calls visit(shapeId, component, bounds) for every component shape whose bounds
+    // overlap the rectangle until it returns false
+    template <typename Visit>
+    void forEachShapeIn(float minX, float minY, float maxX, float maxY, uint64_t maskBits, Visit&& visit) const;
+
+    void syncMovedBodies();
+    void syncArcadeBodies();
+    void gatherEvents();
+    void gatherArcadeEvents();
+    void dispatchEvents();
+    void recordStepStats(float arcadeStepMs);
 };
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Core.h"
+#include <cstdint>
+#include <string>
+
+// Thin OS layer: everything the engine needs that is not covered by SDL or the C++
+// standard library. Implemented in PlatformWindows.cpp and PlatformPosix.cpp.
+class ENGINE2000_API Platform {
+public:
+	enum class ConsoleColor {
+		White,
+		Yellow,
+		Red
+	};
+
+	// High-resolution monotonic clock
+	static uint64_t getCounter();
+	static uint64_t getCounterFrequency();	// Counter ticks per second
+
+	// Console output
+	static void setConsoleColor(ConsoleColor color);
+
+	// File paths
+	static char getPathSeparator();
+	static std::string getWorkingDirectory();
+	static bool fileExists(const std::string& path);
+
+	// Maps a path written for a case-insensitive file system onto the file that exists;
+	// returns the path unchanged if there is no match
+	static std::string resolvePath(const std::string& path);
+};
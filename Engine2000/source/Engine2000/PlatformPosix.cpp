@@ -0,0 +1,99 @@
+#include "Platform.h"
+
+#ifdef E2000_PLATFORM_POSIX
+
+#include <dirent.h>
+#include <strings.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <cstdio>
+
+uint64_t Platform::getCounter()
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + static_cast<uint64_t>(now.tv_nsec);
+}
+
+uint64_t Platform::getCounterFrequency()
+{
+	return 1000000000ull;
+}
+
+void Platform::setConsoleColor(ConsoleColor color)
+{
+	// ANSI escapes only when writing to a terminal, so redirected logs stay clean
+	static const bool isTerminal = isatty(fileno(stdout)) != 0;
+	if (!isTerminal) return;
+
+	switch (color) {
+	case ConsoleColor::White:
+		fputs("\033[0m", stdout);
+		break;
+	case ConsoleColor::Yellow:
+		fputs("\033[33m", stdout);
+		break;
+	case ConsoleColor::Red:
+		fputs("\033[31m", stdout);
+		break;
+	}
+}
+
+char Platform::getPathSeparator()
+{
+	return '/';
+}
+
+std::string Platform::getWorkingDirectory()
+{
+	char buffer[4096];
+	if (!getcwd(buffer, sizeof(buffer))) return std::string();
+	return buffer;
+}
+
+bool Platform::fileExists(const std::string& path)
+{
+	struct stat info;
+	return stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+std::string Platform::resolvePath(const std::string& path)
+{
+	if (path.empty() || fileExists(path)) return path;
+
+	// Asset paths were written on Windows ("graphics/font8x8.bmp" is Font8x8.bmp on disk):
+	// walk the components and match each one case-insensitively
+	std::string resolved = path[0] == '/' ? "/" : "";
+	size_t start = path[0] == '/' ? 1 : 0;
+	while (start <= path.size())
+	{
+		size_t end = path.find_first_of("/\\", start);
+		if (end == std::string::npos) end = path.size();
+		std::string component = path.substr(start, end - start);
+		start = end + 1;
+		if (component.empty()) continue;
+
+		std::string directory = resolved.empty() ? "." : resolved;
+		std::string match = component;
+		if (DIR* dir = opendir(directory.c_str()))
+		{
+			while (dirent* entry = readdir(dir))
+			{
+				if (strcasecmp(entry->d_name, component.c_str()) == 0)
+				{
+					match = entry->d_name;
+					break;
+				}
+			}
+			closedir(dir);
+		}
+
+		if (!resolved.empty() && resolved.back() != '/') resolved += '/';
+		resolved += match;
+	}
+
+	return fileExists(resolved) ? resolved : path;
+}
+
+#endif
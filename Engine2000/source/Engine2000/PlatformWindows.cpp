@@ -0,0 +1,62 @@
+#include "Platform.h"
+
+#ifdef E2000_PLATFORM_WINDOWS
+
+#include <windows.h>
+#include <direct.h>
+
+uint64_t Platform::getCounter()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return static_cast<uint64_t>(counter.QuadPart);
+}
+
+uint64_t Platform::getCounterFrequency()
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	return static_cast<uint64_t>(frequency.QuadPart);
+}
+
+void Platform::setConsoleColor(ConsoleColor color)
+{
+	HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+	switch (color) {
+	case ConsoleColor::White:
+		SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+		break;
+	case ConsoleColor::Yellow:
+		SetConsoleTextAttribute(hConsole, FOREGROUND_RED | FOREGROUND_GREEN);
+		break;
+	case ConsoleColor::Red:
+		SetConsoleTextAttribute(hConsole, FOREGROUND_RED);
+		break;
+	}
+}
+
+char Platform::getPathSeparator()
+{
+	return '\\';
+}
+
+std::string Platform::getWorkingDirectory()
+{
+	char buffer[MAX_PATH];
+	if (!_getcwd(buffer, MAX_PATH)) return std::string();
+	return buffer;
+}
+
+bool Platform::fileExists(const std::string& path)
+{
+	DWORD attributes = GetFileAttributesA(path.c_str());
+	return attributes != INVALID_FILE_ATTRIBUTES && !(attributes & FILE_ATTRIBUTE_DIRECTORY);
+}
+
+std::string Platform::resolvePath(const std::string& path)
+{
+	// NTFS is case-insensitive already
+	return path;
+}
+
+#endif
@@ -0,0 +1,205 @@
+#include "Profiler.h"
+#include "Platform.h"
+#include "E2Log.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+	struct Zone
+	{
+		const char* name;
+		uint64_t start;
+		uint64_t end;
+	};
+
+	// Written only by its owning thread; count is published with release so the
+	// writer of the trace sees complete zones
+	struct ThreadBuffer
+	{
+		static constexpr size_t CAPACITY = 1 << 16;
+
+		uint32_t threadIndex = 0;
+		std::vector<Zone> zones;
+		std::atomic<size_t> count{ 0 };
+		std::atomic<int> dropped{ 0 };
+	};
+
+	thread_local ThreadBuffer* t_buffer = nullptr;
+}
+
+class Profiler::ProfilerImpl
+{
+public:
+	std::atomic<bool> capturing{ false };
+	int framesRemaining = 0;
+	std::string filePath;
+	uint64_t captureStart = 0;
+	ProfilerStats stats;
+
+	std::mutex threadsMutex;	// Only taken when a thread records its first zone
+	std::vector<std::unique_ptr<ThreadBuffer>> threads;
+
+	ThreadBuffer* registerThread()
+	{
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->threadIndex = static_cast<uint32_t>(threads.size());
+		buffer->zones.resize(ThreadBuffer::CAPACITY);
+		threads.push_back(std::move(buffer));
+		return threads.back().get();
+	}
+
+	void record(const char* name, uint64_t start, uint64_t end)
+	{
+		ThreadBuffer* buffer = t_buffer;
+		if (!buffer)
+		{
+			buffer = registerThread();
+			t_buffer = buffer;
+		}
+
+		size_t index = buffer->count.load(std::memory_order_relaxed);
+		if (index >= ThreadBuffer::CAPACITY)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		buffer->zones[index] = { name, start, end };
+		buffer->count.store(index + 1, std::memory_order_release);
+	}
+
+	void resetBuffers()
+	{
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		for (auto& buffer : threads)
+		{
+			buffer->count.store(0, std::memory_order_relaxed);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	static void writeEscaped(FILE* file, const char* text)
+	{
+		for (const char* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\') fputc('\\', file);
+			fputc(*c, file);
+		}
+	}
+
+	void write()
+	{
+		FILE* file = fopen(filePath.c_str(), "w");
+		if (!file)
+		{
+			E2_LOG(Error, "Profiler: could not open %s", filePath.c_str());
+			return;
+		}
+
+		const double ticksToMicroseconds = 1000000.0 / Platform::getCounterFrequency();
+		bool first = true;
+
+		fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+
+		std::lock_guard<std::mutex> lock(threadsMutex);
+		for (auto& buffer : threads)
+		{
+			size_t count = buffer->count.load(std::memory_order_acquire);
+			for (size_t i = 0; i < count; i++)
+			{
+				const Zone& zone = buffer->zones[i];
+				fputs(first ? "\n" : ",\n", file);
+				first = false;
+
+				// Complete ("X") events; viewers nest them by time on each thread track
+				fputs("{\"name\":\"", file);
+				writeEscaped(file, zone.name);
+				fprintf(file, "\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+					buffer->threadIndex,
+					(zone.start - captureStart) * ticksToMicroseconds,
+					(zone.end - zone.start) * ticksToMicroseconds);
+			}
+			stats.zonesRecorded += static_cast<int>(count);
+			stats.zonesDropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+		stats.threads = static_cast<int>(threads.size());
+
+		fputs("\n]}\n", file);
+		fclose(file);
+
+		E2_LOG(Log, "Profiler: wrote %d zones over %d frames to %s (%d dropped)",
+			stats.zonesRecorded, stats.framesCaptured, filePath.c_str(), stats.zonesDropped);
+	}
+};
+
+Profiler& Profiler::Instance()
+{
+	static Profiler instance;
+	return instance;
+}
+
+Profiler::Profiler() : pimpl(new ProfilerImpl()) {}
+Profiler::~Profiler() { delete pimpl; }
+
+void Profiler::beginCapture(int frameCount, const char* filePath)
+{
+#ifndef E2_PROFILER_ENABLED
+	E2_LOG(Warning, "Profiler: zones are compiled out; define ENGINE2000_ENABLE_PROFILER to capture");
+#endif
+	if (frameCount <= 0 || pimpl->capturing.load()) return;
+
+	pimpl->resetBuffers();
+	pimpl->stats = ProfilerStats();
+	pimpl->framesRemaining = frameCount;
+	pimpl->filePath = filePath;
+	pimpl->captureStart = Platform::getCounter();
+	pimpl->capturing.store(true, std::memory_order_release);
+}
+
+bool Profiler::isCapturing() const
+{
+	return pimpl->capturing.load(std::memory_order_relaxed);
+}
+
+void Profiler::endFrame()
+{
+	if (!isCapturing()) return;
+
+	pimpl->stats.framesCaptured++;
+	if (--pimpl->framesRemaining > 0) return;
+
+	pimpl->capturing.store(false, std::memory_order_release);
+	pimpl->write();
+}
+
+void Profiler::record(const char* name, uint64_t start, uint64_t end)
+{
+	pimpl->record(name, start, end);
+}
+
+const ProfilerStats& Profiler::getStats() const
+{
+	return pimpl->stats;
+}
+
+ProfileScope::ProfileScope(const char* name)
+	: m_name(name)
+	, m_start(Profiler::Instance().isCapturing() ? Platform::getCounter() : 0)
+{
+}
+
+ProfileScope::~ProfileScope()
+{
+	// A zone that began before the capture started is not recorded
+	if (m_start != 0 && Profiler::Instance().isCapturing())
+	{
+		Profiler::Instance().record(m_name, m_start, Platform::getCounter());
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Core.h"
+#include <cstdint>
+
+// Zones are compiled in for debug builds, or anywhere ENGINE2000_ENABLE_PROFILER is defined
+#if defined(ENGINE2000_BUILD_DEBUG) || defined(ENGINE2000_ENABLE_PROFILER)
+	#define E2_PROFILER_ENABLED 1
+#endif
+
+#define E2_PROFILE_CONCAT_INNER(a, b) a##b
+#define E2_PROFILE_CONCAT(a, b) E2_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef E2_PROFILER_ENABLED
+	// name must outlive the capture (a string literal)
+	#define E2_PROFILE_SCOPE(name) ProfileScope E2_PROFILE_CONCAT(e2ProfileScope, __LINE__)(name)
+	#define E2_PROFILE_FUNCTION() E2_PROFILE_SCOPE(__FUNCTION__)
+#else
+	#define E2_PROFILE_SCOPE(name) ((void)0)
+	#define E2_PROFILE_FUNCTION() ((void)0)
+#endif
+
+struct ProfilerStats
+{
+	int framesCaptured = 0;
+	int zonesRecorded = 0;
+	int zonesDropped = 0;	// A thread's buffer was full
+	int threads = 0;
+};
+
+// Records nested timing zones for a number of frames and writes them as a Chrome
+// trace_event JSON file (chrome://tracing, ui.perfetto.dev). Each thread appends to
+// its own buffer, so recording takes no lock; only a thread's first zone registers it.
+class ENGINE2000_API Profiler {
+private:
+	// Singleton pattern
+	Profiler();
+	~Profiler();
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	class ProfilerImpl;
+	ProfilerImpl* pimpl;
+
+public:
+	static Profiler& Instance();
+
+	// Starts recording; the trace is written to filePath after frameCount frames
+	void beginCapture(int frameCount, const char* filePath = "trace.json");
+	bool isCapturing() const;
+
+	// Called by GameEngine once per frame
+	void endFrame();
+
+	// Appends a finished zone for the calling thread (Platform::getCounter ticks)
+	void record(const char* name, uint64_t start, uint64_t end);
+
+	const ProfilerStats& getStats() const;
+};
+
+// RAII zone; use through E2_PROFILE_SCOPE
+class ENGINE2000_API ProfileScope {
+private:
+	const char* m_name;
+	uint64_t m_start;
+
+public:
+	explicit ProfileScope(const char* name);
+	~ProfileScope();
+};
@@ -56,6 +56,23 @@ void Projectile::onBoundsDestroy()
     }
 }
 
+void Projectile::onAcquire()
+{
+	// Spawn sites set position, direction and speed after acquiring
+	m_isActive = true;
+	m_direction = Vector2D(0.0f, -1.0f);
+	m_speed = 0.0f;
+	m_boundsComponent->reset();
+	m_physics->clearImmunity();
+	m_physics->setBodyEnabled(true);
+}
+
+void Projectile::onRelease()
+{
+	m_isActive = false;
+	m_physics->setBodyEnabled(false);
+}
+
 void Projectile::setPosition(float x, float y)
 {
 	getTransform()->setPosition(x, y);
@@ -28,6 +28,10 @@ public:
 
 	virtual void onBoundsDestroy() override;
 
+	// Pooling hooks (Level::acquireGameObject)
+	virtual void onAcquire() override;
+	virtual void onRelease() override;
+
     // Sensor methods
     virtual void onSensorBegin(GameObject* other) override {};
     virtual void onSensorEnd(GameObject* other) override {};
@@ -2,6 +2,8 @@
 #include "EngineError.h"
 #include "Window.h"
 #include "E2Log.h"
+#include "Platform.h"
+#include "Profiler.h"
 
 #include <SDL2/SDL.h>
 #include <glm/glm.hpp>
@@ -11,12 +13,42 @@
 #include <iostream>
 #include <fstream>
 #include <sstream>
-#include <direct.h> // for _getcwd
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 
 class Renderer::RendererImpl
 {
 private:
+	// Interleaved sprite vertex: position (already in screen space), texcoord and tint
+	struct SpriteVertex
+	{
+		float x, y;
+		float u, v;
+		float r, g, b, a;
+	};
+
+	// Debug rectangles are coloured, untextured vertices in the debug shader's layout
+	struct DebugVertex
+	{
+		float x, y;
+		float r, g, b, a;
+	};
+
+	// One queued quad; the key packs (layer, texture) so a single sort groups each run
+	struct QueuedSprite
+	{
+		uint64_t key;
+		uint32_t order;
+		SpriteVertex vertices[4];
+	};
+
+	// Quads per draw call; indices are 16-bit so this must stay below 16384
+	static constexpr int MAX_BATCH_SPRITES = 4096;
+
 	Window* m_window;
+	RenderBackend m_backend;
 	bool m_useOpenGL;
 
 	// SDL2 specific members
@@ -30,12 +62,11 @@ private:
 	GLuint m_spriteVBO;
 	GLuint m_debugVAO;
 	GLuint m_debugVBO;
+	GLuint m_spriteEBO;
 	GLuint m_debugModelLoc;
 	GLuint m_debugProjLoc;
-	GLuint m_modelLoc;
 	GLuint m_projectionLoc;
 	GLuint m_textureLoc;
-	GLuint m_colorLoc;
 	glm::mat4 m_projection;
 
 	// Add shader source strings as class members
@@ -44,9 +75,32 @@ private:
 	std::string m_debugVertexShaderSource;
 	std::string m_debugFragmentShaderSource;
 
+	// Sprite batch
+	std::vector<QueuedSprite> m_spriteQueue;
+	std::vector<SpriteVertex> m_batchVertices;
+	int m_currentLayer;
+	float m_interpolationAlpha;
+
+	// Rects keep the layer they were submitted on and are drawn after that layer's sprites
+	struct QueuedRect
+	{
+		uint32_t layer;
+		bool filled;
+		DebugVertex corners[4];	// Top-left, top-right, bottom-right, bottom-left
+	};
+	std::vector<QueuedRect> m_rectQueue;
+
+	// One layer's rects: fills as triangles, outlines as lines
+	std::vector<DebugVertex> m_debugFills;
+	std::vector<DebugVertex> m_debugLines;
+
+	RenderStats m_frameStats;	// Being accumulated for the current frame
+	RenderStats m_lastStats;	// Last completed frame
+
 public:
 	RendererImpl()
 		: m_window(nullptr)
+		, m_backend(RenderBackend::SDL)
 		, m_useOpenGL(false)
 		, m_sdlRenderer(nullptr)
 		, m_glContext(nullptr)
@@ -56,21 +110,27 @@ public:
 		, m_spriteVBO(0)
 		, m_debugVAO(0)
 		, m_debugVBO(0)
-		, m_modelLoc(0)
+		, m_spriteEBO(0)
 		, m_projectionLoc(0)
 		, m_textureLoc(0)
-		, m_colorLoc(0)
 		, m_debugModelLoc(0)
 		, m_debugProjLoc(0)
 		, m_projection(1.0f)
+		, m_currentLayer(0)
+		, m_interpolationAlpha(1.0f)
 	{}
 
-	void init(Window* window, bool useOpenGL)
+	void init(Window* window, RenderBackend backend)
 	{
 		m_window = window;
-		m_useOpenGL = useOpenGL;
+		m_backend = backend;
+		m_useOpenGL = backend == RenderBackend::OpenGL;
 
-		if (m_useOpenGL)
+		if (m_backend == RenderBackend::Null)
+		{
+			E2_LOG(Log, "Null renderer initialized (headless)");
+		}
+		else if (m_useOpenGL)
 		{
 			SDL_GL_MakeCurrent(static_cast<SDL_Window*>(window->getWindow()),
 				static_cast<SDL_GLContext>(window->getGLContext()));
@@ -113,6 +173,11 @@ public:
 				glDeleteBuffers(1, &m_spriteVBO);
 				m_spriteVBO = 0;
 			}
+			if (m_spriteEBO)
+			{
+				glDeleteBuffers(1, &m_spriteEBO);
+				m_spriteEBO = 0;
+			}
 			if (m_debugVAO)
 			{
 				glDeleteVertexArrays(1, &m_debugVAO);
@@ -150,7 +215,7 @@ private:
 	}
 
 	std::string loadShaderFromFile(const char* filePath) {
-		std::ifstream shaderFile(filePath);
+		std::ifstream shaderFile(Platform::resolvePath(filePath));
 		if (!shaderFile.is_open()) {
 			E2_LOG(Error, "Failed to open shader file: %s", filePath);
 			throw EngineError("Failed to open shader file");
@@ -193,36 +258,11 @@ private:
 		glDeleteShader(vertexShader);
 		glDeleteShader(fragmentShader);
 
-		glGenVertexArrays(1, &m_spriteVAO);
-		glGenBuffers(1, &m_spriteVBO);
-
-		glBindVertexArray(m_spriteVAO);
-
-		// Create quad vertices
-		float vertices[] = {
-			// pos      // tex
-			0.0f, 1.0f, 0.0f, 0.0f,  // top left
-			1.0f, 1.0f, 1.0f, 0.0f,  // top right
-			0.0f, 0.0f, 0.0f, 1.0f,  // bottom left
-			1.0f, 0.0f, 1.0f, 1.0f   // bottom right
-		};
-
-		glBindBuffer(GL_ARRAY_BUFFER, m_spriteVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-		// Position attribute
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
-		glEnableVertexAttribArray(0);
-
-		// Texture coord attribute
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
-		glEnableVertexAttribArray(1);
+		setupSpriteBuffers();
 
 		// Get uniform locations for sprite shader
-		m_modelLoc = glGetUniformLocation(m_defaultShaderProgram, "model");
 		m_projectionLoc = glGetUniformLocation(m_defaultShaderProgram, "projection");
 		m_textureLoc = glGetUniformLocation(m_defaultShaderProgram, "mainTexture");
-		m_colorLoc = glGetUniformLocation(m_defaultShaderProgram, "color");
 
 		// Set up projection matrix
 		int width, height;
@@ -251,85 +291,6 @@ private:
 		E2_LOG(Log, "SDL2 Renderer initialized");
 	}
 
-	void createDefaultShader()
-	{
-		// Use the class member variables
-		const char* vertexSourcePtr = m_vertexShaderSource.c_str();
-		GLuint vertexShader = glCreateShader(GL_VERTEX_SHADER);
-		glShaderSource(vertexShader, 1, &vertexSourcePtr, NULL);
-		glCompileShader(vertexShader);
-
-		// Check vertex shader compilation
-		GLint success;
-		char infoLog[512];
-		glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-		if (!success) {
-			glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-			E2_LOG(Error, "Vertex shader compilation failed:\n%s", infoLog);
-			return;
-		}
-
-		// Create fragment shader
-		const char* fragmentSourcePtr = m_fragmentShaderSource.c_str();
-		GLuint fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-		glShaderSource(fragmentShader, 1, &fragmentSourcePtr, NULL);
-		glCompileShader(fragmentShader);
-
-		// Check fragment shader compilation
-		glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-		if (!success) {
-			glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-			E2_LOG(Error, "Fragment shader compilation failed:\n%s", infoLog);
-			return;
-		}
-
-		// Create shader program
-		m_defaultShaderProgram = glCreateProgram();
-		glAttachShader(m_defaultShaderProgram, vertexShader);
-		glAttachShader(m_defaultShaderProgram, fragmentShader);
-		glLinkProgram(m_defaultShaderProgram);
-
-		// Check program linking
-		glGetProgramiv(m_defaultShaderProgram, GL_LINK_STATUS, &success);
-		if (!success) {
-			glGetProgramInfoLog(m_defaultShaderProgram, 512, NULL, infoLog);
-			E2_LOG(Error, "Shader program linking failed:\n%s", infoLog);
-			return;
-		}
-
-		// Cache all uniform locations after successful linking
-		m_modelLoc = glGetUniformLocation(m_defaultShaderProgram, "model");
-		m_projectionLoc = glGetUniformLocation(m_defaultShaderProgram, "projection");
-		m_textureLoc = glGetUniformLocation(m_defaultShaderProgram, "mainTexture");
-		m_colorLoc = glGetUniformLocation(m_defaultShaderProgram, "color");
-
-		// Log uniform locations
-		E2_LOG(Log, "Uniform locations cached - model: %d, proj: %d, tex: %d, color: %d",
-			m_modelLoc, m_projectionLoc, m_textureLoc, m_colorLoc);
-
-		// Setup projection matrix
-		int width = 640;  // Your window width
-		int height = 480; // Your window height
-		m_projection = glm::ortho(0.0f, static_cast<float>(width),
-			static_cast<float>(height), 0.0f, -1.0f, 1.0f);
-
-		// Set initial projection matrix
-		glUseProgram(m_defaultShaderProgram);
-		if (m_projectionLoc != -1) {
-			glUniformMatrix4fv(m_projectionLoc, 1, GL_FALSE, glm::value_ptr(m_projection));
-			GLenum error = glGetError();
-			if (error != GL_NO_ERROR) {
-				E2_LOG(Error, "Error setting initial projection matrix: %d", error);
-			}
-		}
-
-		// Cleanup shaders
-		glDeleteShader(vertexShader);
-		glDeleteShader(fragmentShader);
-
-		E2_LOG(Log, "Shader program created successfully: %u", m_defaultShaderProgram);
-	}
-
 	void createDebugShader()
 	{
 		// Load debug shader sources from files with correct path
@@ -412,39 +373,52 @@ private:
 
 	void setupSpriteBuffers()
 	{
-		float vertices[] = {
-			// pos      // tex
-			0.0f, 1.0f, 0.0f, 0.0f,  // top left
-			1.0f, 0.0f, 1.0f, 1.0f,  // bottom right
-			0.0f, 0.0f, 0.0f, 1.0f,  // bottom left
-
-			0.0f, 1.0f, 0.0f, 0.0f,  // top left
-			1.0f, 1.0f, 1.0f, 0.0f,  // top right
-			1.0f, 0.0f, 1.0f, 1.0f   // bottom right
-		};
+		// Index pattern never changes, so it is built once for the largest batch
+		std::vector<GLushort> indices(MAX_BATCH_SPRITES * 6);
+		for (int i = 0; i < MAX_BATCH_SPRITES; ++i)
+		{
+			GLushort base = static_cast<GLushort>(i * 4);
+			indices[i * 6 + 0] = base + 0;
+			indices[i * 6 + 1] = base + 1;
+			indices[i * 6 + 2] = base + 2;
+			indices[i * 6 + 3] = base + 2;
+			indices[i * 6 + 4] = base + 1;
+			indices[i * 6 + 5] = base + 3;
+		}
 
-		// Generate and bind VAO first
 		glGenVertexArrays(1, &m_spriteVAO);
 		glBindVertexArray(m_spriteVAO);
 
-		// Generate and bind VBO
+		// Streaming vertex buffer, orphaned and refilled on every flush
 		glGenBuffers(1, &m_spriteVBO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_spriteVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, MAX_BATCH_SPRITES * 4 * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+
+		glGenBuffers(1, &m_spriteEBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_spriteEBO);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLushort), indices.data(), GL_STATIC_DRAW);
 
 		// Position attribute
-		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, x));
 		glEnableVertexAttribArray(0);
 
 		// Texture coord attribute
-		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, u));
 		glEnableVertexAttribArray(1);
 
-		// Unbind VBO and VAO
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		// Tint attribute
+		glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, r));
+		glEnableVertexAttribArray(2);
+
+		// Unbind VAO first so it keeps the element buffer binding
 		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-		E2_LOG(Log, "Sprite buffers created - VAO: %u, VBO: %u", m_spriteVAO, m_spriteVBO);
+		m_spriteQueue.reserve(MAX_BATCH_SPRITES);
+		m_batchVertices.reserve(MAX_BATCH_SPRITES * 4);
+
+		E2_LOG(Log, "Sprite batch created - VAO: %u, VBO: %u, capacity: %d sprites",
+			m_spriteVAO, m_spriteVBO, MAX_BATCH_SPRITES);
 	}
 
 	void setupDebugBuffers()
@@ -456,8 +430,8 @@ private:
 		glBindVertexArray(m_debugVAO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_debugVBO);
 
-		// We'll update the buffer data dynamically in drawDebugRect
-		glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 24, nullptr, GL_DYNAMIC_DRAW);
+		// Refilled with each layer's rects in flush
+		glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
 
 		// Position attribute
 		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
@@ -476,11 +450,16 @@ private:
 public:
 	void clear()
 	{
+		m_frameStats = RenderStats();
+		m_currentLayer = 0;
+
 		if (m_useOpenGL)
 		{
+			m_spriteQueue.clear();
+			m_rectQueue.clear();
 			glClear(GL_COLOR_BUFFER_BIT);
 		}
-		else
+		else if (m_backend == RenderBackend::SDL)
 		{
 			SDL_RenderClear(m_sdlRenderer);
 		}
@@ -490,12 +469,35 @@ public:
 	{
 		if (m_useOpenGL)
 		{
+			flush();
 			SDL_GL_SwapWindow(static_cast<SDL_Window*>(m_window->getWindow()));
 		}
-		else
+		else if (m_backend == RenderBackend::SDL)
 		{
 			SDL_RenderPresent(m_sdlRenderer);
 		}
+
+		m_lastStats = m_frameStats;
+	}
+
+	void setLayer(int layer)
+	{
+		m_currentLayer = layer;
+	}
+
+	void setInterpolationAlpha(float alpha)
+	{
+		m_interpolationAlpha = alpha;
+	}
+
+	float getInterpolationAlpha() const
+	{
+		return m_interpolationAlpha;
+	}
+
+	const RenderStats& getStats() const
+	{
+		return m_lastStats;
 	}
 
 	void setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
@@ -504,7 +506,7 @@ public:
 		{
 			glClearColor(r / 255.0f, g / 255.0f, b / 255.0f, a / 255.0f);
 		}
-		else
+		else if (m_backend == RenderBackend::SDL)
 		{
 			SDL_SetRenderDrawColor(m_sdlRenderer, r, g, b, a);
 		}
@@ -520,7 +522,22 @@ public:
 		return m_useOpenGL;
 	}
 
-	void drawTextureGL(GLuint textureId, const Vector4D& texCoords, const Vector4D& screenPos)
+	RenderBackend getBackend() const
+	{
+		return m_backend;
+	}
+
+	void drawNull(int vertexCount)
+	{
+		m_frameStats.drawCalls++;
+		m_frameStats.vertices += vertexCount;
+		if (vertexCount == 4)
+		{
+			m_frameStats.sprites++;
+		}
+	}
+
+	void drawTextureGL(GLuint textureId, const Vector4D& texCoords, const Vector4D& screenPos, const Vector4D& tint)
 	{
 		// First verify the texture exists
 		if (textureId == 0)
@@ -529,49 +546,168 @@ public:
 			return;
 		}
 
-		glUseProgram(m_defaultShaderProgram);
-		
-		// Set color uniform (white by default)
-		glUniform4f(m_colorLoc, 1.0f, 1.0f, 1.0f, 1.0f);
-		
-		// Set up model matrix
-		glm::mat4 model = glm::mat4(1.0f);
-		model = glm::translate(model, glm::vec3(screenPos.x, screenPos.y, 0.0f));
-		model = glm::scale(model, glm::vec3(screenPos.w, screenPos.h, 1.0f));
+		QueuedSprite sprite;
+		sprite.key = (static_cast<uint64_t>(static_cast<uint32_t>(m_currentLayer)) << 32) | textureId;
+		sprite.order = static_cast<uint32_t>(m_spriteQueue.size());
+
+		// Corners are transformed here so the whole batch shares one projection
+		float left = screenPos.x;
+		float top = screenPos.y;
+		float right = screenPos.x + screenPos.w;
+		float bottom = screenPos.y + screenPos.h;
+		float texLeft = texCoords.x;
+		float texTop = texCoords.y;
+		float texRight = texCoords.x + texCoords.w;
+		float texBottom = texCoords.y + texCoords.h;
+
+		sprite.vertices[0] = { left,  top,    texLeft,  texTop,    tint.x, tint.y, tint.w, tint.h };
+		sprite.vertices[1] = { right, top,    texRight, texTop,    tint.x, tint.y, tint.w, tint.h };
+		sprite.vertices[2] = { left,  bottom, texLeft,  texBottom, tint.x, tint.y, tint.w, tint.h };
+		sprite.vertices[3] = { right, bottom, texRight, texBottom, tint.x, tint.y, tint.w, tint.h };
+
+		m_spriteQueue.push_back(sprite);
+		m_frameStats.sprites++;
+	}
 
-		// Set uniforms
-		glUniformMatrix4fv(m_modelLoc, 1, GL_FALSE, glm::value_ptr(model));
-		glUniformMatrix4fv(m_projectionLoc, 1, GL_FALSE, glm::value_ptr(m_projection));
+	void flush()
+	{
+		if (!m_useOpenGL || (m_spriteQueue.empty() && m_rectQueue.empty())) return;
+		E2_PROFILE_SCOPE("Renderer::flush");
+
+		// Order by layer, then texture; submission order breaks ties so the sort is stable
+		std::sort(m_spriteQueue.begin(), m_spriteQueue.end(),
+			[](const QueuedSprite& a, const QueuedSprite& b) {
+				return a.key != b.key ? a.key < b.key : a.order < b.order;
+			});
+		std::stable_sort(m_rectQueue.begin(), m_rectQueue.end(),
+			[](const QueuedRect& a, const QueuedRect& b) { return a.layer < b.layer; });
+
+		// Lowest layer first: its sprites, then its rects over them
+		size_t sprite = 0;
+		size_t rect = 0;
+		while (sprite < m_spriteQueue.size() || rect < m_rectQueue.size())
+		{
+			uint32_t layer = UINT32_MAX;
+			if (sprite < m_spriteQueue.size()) layer = static_cast<uint32_t>(m_spriteQueue[sprite].key >> 32);
+			if (rect < m_rectQueue.size()) layer = std::min(layer, m_rectQueue[rect].layer);
+
+			size_t spriteEnd = sprite;
+			while (spriteEnd < m_spriteQueue.size() && static_cast<uint32_t>(m_spriteQueue[spriteEnd].key >> 32) == layer) ++spriteEnd;
+			size_t rectEnd = rect;
+			while (rectEnd < m_rectQueue.size() && m_rectQueue[rectEnd].layer == layer) ++rectEnd;
+
+			drawSprites(sprite, spriteEnd);
+			drawRects(rect, rectEnd);
+			sprite = spriteEnd;
+			rect = rectEnd;
+		}
 
-		// Make sure the proper texture unit is active
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, textureId);
-		glUniform1i(m_textureLoc, 0);  // Tell shader to use texture unit 0
+		m_spriteQueue.clear();
+		m_rectQueue.clear();
+	}
+
+	// Queued sprites [begin, end), already sorted by texture
+	void drawSprites(size_t begin, size_t end)
+	{
+		if (begin == end) return;
 
-		float vertices[] = {
-			// pos      // tex
-			0.0f, 0.0f, texCoords.x, texCoords.y,                    // bottom left
-			1.0f, 0.0f, texCoords.x + texCoords.w, texCoords.y,      // bottom right
-			0.0f, 1.0f, texCoords.x, texCoords.y + texCoords.h,      // top left
-			1.0f, 1.0f, texCoords.x + texCoords.w, texCoords.y + texCoords.h  // top right
-		};
+		glUseProgram(m_defaultShaderProgram);
+		glUniformMatrix4fv(m_projectionLoc, 1, GL_FALSE, glm::value_ptr(m_projection));
+		glUniform1i(m_textureLoc, 0);
+		glActiveTexture(GL_TEXTURE0);
 
 		glBindVertexArray(m_spriteVAO);
 		glBindBuffer(GL_ARRAY_BUFFER, m_spriteVBO);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
 
-		// Draw as two triangles
-		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-		
+		size_t runStart = begin;
+		while (runStart < end)
+		{
+			// A run shares one texture and is capped by the index buffer size
+			GLuint textureId = static_cast<GLuint>(m_spriteQueue[runStart].key & 0xFFFFFFFFu);
+			size_t runEnd = runStart;
+			m_batchVertices.clear();
+			while (runEnd < end
+				&& static_cast<GLuint>(m_spriteQueue[runEnd].key & 0xFFFFFFFFu) == textureId
+				&& runEnd - runStart < MAX_BATCH_SPRITES)
+			{
+				const QueuedSprite& sprite = m_spriteQueue[runEnd];
+				m_batchVertices.insert(m_batchVertices.end(), sprite.vertices, sprite.vertices + 4);
+				++runEnd;
+			}
+
+			GLsizei spriteCount = static_cast<GLsizei>(runEnd - runStart);
+
+			// Orphan the previous storage so the driver does not stall on in-flight draws
+			glBufferData(GL_ARRAY_BUFFER, MAX_BATCH_SPRITES * 4 * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+			glBufferSubData(GL_ARRAY_BUFFER, 0, m_batchVertices.size() * sizeof(SpriteVertex), m_batchVertices.data());
+
+			glBindTexture(GL_TEXTURE_2D, textureId);
+			glDrawElements(GL_TRIANGLES, spriteCount * 6, GL_UNSIGNED_SHORT, nullptr);
+
+			m_frameStats.drawCalls++;
+			m_frameStats.vertices += spriteCount * 4;
+			runStart = runEnd;
+		}
+
 		// Clean up
 		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
 		glBindTexture(GL_TEXTURE_2D, 0);
 		glUseProgram(0);
 	}
 
+	// Queued rects [begin, end) of one layer, in submission order
+	void drawRects(size_t begin, size_t end)
+	{
+		if (begin == end) return;
+
+		m_debugFills.clear();
+		m_debugLines.clear();
+		for (size_t i = begin; i < end; i++)
+		{
+			const DebugVertex* c = m_rectQueue[i].corners;
+			if (m_rectQueue[i].filled)
+			{
+				m_debugFills.insert(m_debugFills.end(), { c[0], c[1], c[2], c[0], c[2], c[3] });
+			}
+			else
+			{
+				m_debugLines.insert(m_debugLines.end(), { c[0], c[1], c[1], c[2], c[2], c[3], c[3], c[0] });
+			}
+		}
+
+		glUseProgram(m_debugShaderProgram);
+		glm::mat4 model = glm::mat4(1.0f);
+		glUniformMatrix4fv(m_debugModelLoc, 1, GL_FALSE, glm::value_ptr(model));
+		glUniformMatrix4fv(m_debugProjLoc, 1, GL_FALSE, glm::value_ptr(m_projection));
+
+		glBindVertexArray(m_debugVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_debugVBO);
+
+		// Fills first so outlines stay visible over them; one draw call each
+		for (const std::vector<DebugVertex>* batch : { &m_debugFills, &m_debugLines })
+		{
+			if (batch->empty()) continue;
+
+			glBufferData(GL_ARRAY_BUFFER, batch->size() * sizeof(DebugVertex), batch->data(), GL_STREAM_DRAW);
+			glDrawArrays(batch == &m_debugFills ? GL_TRIANGLES : GL_LINES, 0, static_cast<GLsizei>(batch->size()));
+
+			m_frameStats.drawCalls++;
+			m_frameStats.vertices += static_cast<int>(batch->size());
+		}
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		glUseProgram(0);
+	}
+
 	void drawRect(const Vector4D& rect, const Vector4D& color)
 	{
-		if (m_useOpenGL) {
+		if (m_backend == RenderBackend::Null) {
+			m_frameStats.drawCalls++;
+			m_frameStats.vertices += 4;
+		}
+		else if (m_useOpenGL) {
 			// Color is already in 0-1 range for OpenGL
 			drawDebugRect(rect, color, false);
 		}
@@ -595,7 +731,11 @@ public:
 
 	void fillRect(const Vector4D& rect, const Vector4D& color)
 	{
-		if (m_useOpenGL) {
+		if (m_backend == RenderBackend::Null) {
+			m_frameStats.drawCalls++;
+			m_frameStats.vertices += 4;
+		}
+		else if (m_useOpenGL) {
 			drawDebugRect(rect, color, true); // true = filled
 		}
 		else {
@@ -612,34 +752,20 @@ public:
 
 	void drawDebugRect(const Vector4D& rect, const Vector4D& color, bool filled)
 	{
-		glUseProgram(m_debugShaderProgram);
-
-		float normalizedColor[] = {
-			color.x / 255.0f,
-			color.y / 255.0f,
-			color.w / 255.0f,
-			color.h / 255.0f
-		};
-
-		glm::mat4 model = glm::mat4(1.0f);
-		glUniformMatrix4fv(m_debugModelLoc, 1, GL_FALSE, glm::value_ptr(model));
-		glUniformMatrix4fv(m_debugProjLoc, 1, GL_FALSE, glm::value_ptr(m_projection));
-
-		float vertices[] = {
-			rect.x, rect.y,       normalizedColor[0], normalizedColor[1], normalizedColor[2], normalizedColor[3],
-			rect.x + rect.w, rect.y,   normalizedColor[0], normalizedColor[1], normalizedColor[2], normalizedColor[3],
-			rect.x + rect.w, rect.y + rect.h, normalizedColor[0], normalizedColor[1], normalizedColor[2], normalizedColor[3],
-			rect.x, rect.y + rect.h,   normalizedColor[0], normalizedColor[1], normalizedColor[2], normalizedColor[3]
-		};
-
-		glBindVertexArray(m_debugVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, m_debugVBO);
-		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-
-		glDrawArrays(filled ? GL_TRIANGLE_FAN : GL_LINE_LOOP, 0, 4);
-
-		glBindVertexArray(0);
-		glUseProgram(0);
+		// Queued, not drawn: flush draws it after the sprites of the current layer
+		const float r = color.x / 255.0f;
+		const float g = color.y / 255.0f;
+		const float b = color.w / 255.0f;
+		const float a = color.h / 255.0f;
+
+		QueuedRect queued;
+		queued.layer = static_cast<uint32_t>(m_currentLayer);
+		queued.filled = filled;
+		queued.corners[0] = { rect.x, rect.y, r, g, b, a };
+		queued.corners[1] = { rect.x + rect.w, rect.y, r, g, b, a };
+		queued.corners[2] = { rect.x + rect.w, rect.y + rect.h, r, g, b, a };
+		queued.corners[3] = { rect.x, rect.y + rect.h, r, g, b, a };
+		m_rectQueue.push_back(queued);
 	}
 };
 
@@ -653,7 +779,7 @@ Renderer& Renderer::Instance()
 Renderer::Renderer() : pimpl(new RendererImpl()) {}
 Renderer::~Renderer() { delete pimpl; }
 
-void Renderer::init(Window* window, bool useOpenGL) { pimpl->init(window, useOpenGL); }
+void Renderer::init(Window* window, RenderBackend backend) { pimpl->init(window, backend); }
 
 void Renderer::cleanup() { pimpl->cleanup(); }
 
@@ -661,6 +787,10 @@ void* Renderer::getRenderer() const { return pimpl->getRenderer(); }
 
 bool Renderer::isOpenGL() const { return pimpl->isOpenGL(); }
 
+bool Renderer::isHeadless() const { return pimpl->getBackend() == RenderBackend::Null; }
+
+RenderBackend Renderer::getBackend() const { return pimpl->getBackend(); }
+
 void Renderer::clear() { pimpl->clear(); }
 
 void Renderer::present() { pimpl->present(); }
@@ -670,9 +800,21 @@ void Renderer::setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
 	pimpl->setDrawColor(r, g, b, a);
 }
 
-void Renderer::drawTextureGL(unsigned int textureId, const Vector4D& texCoords, const Vector4D& screenPos)
+void Renderer::setLayer(int layer) { pimpl->setLayer(layer); }
+
+void Renderer::flush() { pimpl->flush(); }
+
+void Renderer::drawNull(int vertexCount) { pimpl->drawNull(vertexCount); }
+
+void Renderer::setInterpolationAlpha(float alpha) { pimpl->setInterpolationAlpha(alpha); }
+
+float Renderer::getInterpolationAlpha() const { return pimpl->getInterpolationAlpha(); }
+
+const RenderStats& Renderer::getStats() const { return pimpl->getStats(); }
+
+void Renderer::drawTextureGL(unsigned int textureId, const Vector4D& texCoords, const Vector4D& screenPos, const Vector4D& tint)
 {
-	pimpl->drawTextureGL(textureId, texCoords, screenPos);
+	pimpl->drawTextureGL(textureId, texCoords, screenPos, tint);
 }
 
 void Renderer::drawRect(const Vector4D& rect, const Vector4D& color)
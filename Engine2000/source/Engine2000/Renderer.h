@@ -5,6 +5,21 @@
 
 class Window;
 
+enum class RenderBackend
+{
+	OpenGL,
+	SDL,
+	Null	// No window or GPU: draws are accepted and counted only (headless runs)
+};
+
+// Per-frame counters for the OpenGL sprite batch
+struct RenderStats
+{
+	int drawCalls = 0;
+	int vertices = 0;
+	int sprites = 0;
+};
+
 class Renderer {
 private:
 	// Singleton pattern
@@ -19,20 +34,39 @@ private:
 public:
 	static Renderer& Instance();
 
-	void init(Window* window, bool useOpenGL = true);
+	void init(Window* window, RenderBackend backend = RenderBackend::OpenGL);
 	void cleanup();
 
 	// Rendering methods
 	void* getRenderer() const;
 	bool isOpenGL() const;
+	bool isHeadless() const;
+	RenderBackend getBackend() const;
 	void clear();
 	void present();
 	void setDrawColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
 
 	// OpenGL specific methods
-	void drawTextureGL(unsigned int textureId, const Vector4D& texCoords, const Vector4D& screenPos);
+	// Queues a quad into the sprite batch; nothing reaches the GPU until flush()
+	void drawTextureGL(unsigned int textureId, const Vector4D& texCoords, const Vector4D& screenPos,
+		const Vector4D& tint = Vector4D(1.0f, 1.0f, 1.0f, 1.0f));
+	void flush();
+
+	// Null backend: counts one draw of vertexCount vertices without touching any graphics API
+	void drawNull(int vertexCount = 4);
+
+	// Sprites and rects are drawn ordered by layer first; sprites then by texture
+	void setLayer(int layer);
+
+	// Blend factor between the previous and current simulation step for this frame
+	void setInterpolationAlpha(float alpha);
+	float getInterpolationAlpha() const;
+
+	// Counters for the last presented frame
+	const RenderStats& getStats() const;
 
 	// Using Vector4D for both rectangle and color (x,y,w,h) and (r,g,b,a)
+	// With OpenGL they are queued on the current layer and drawn over that layer's sprites
 	void drawRect(const Vector4D& rect, const Vector4D& color);
 	void fillRect(const Vector4D& rect, const Vector4D& color);
 };
\ No newline at end of file
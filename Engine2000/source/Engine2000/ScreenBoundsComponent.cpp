@@ -3,6 +3,7 @@
 #include "Level.h"
 #include "SpriteComponent.h"
 #include "PhysicsComponent.h"
+#include "PhysicsWorld.h"
 #include "E2Log.h"
 
 ScreenBoundsComponent::ScreenBoundsComponent(GameObject* owner)
@@ -12,6 +13,7 @@ ScreenBoundsComponent::ScreenBoundsComponent(GameObject* owner)
 	, m_isOutOfBounds(false)
 	, m_isSleeping(false)
 	, m_responder(nullptr)
+	, m_volumeSlot(-1)
 {
 }
 
@@ -24,59 +26,47 @@ void ScreenBoundsComponent::init()
 // 	}
 }
 
-void ScreenBoundsComponent::update(float deltaTime)
+void ScreenBoundsComponent::setBoundaryFlags(const BoundaryFlags& flags)
 {
-	// Skip if sleeping
-	if (m_isSleeping) {
-		// Check if object is back in bounds
-		if (!checkBounds()) {
-			wakeUp();
-		}
-		return;
-	}
+	m_flags = flags;
+	refreshVolume();
+}
 
-	// Check if object is out of bounds
-	if (checkBounds()) {
-		handleOutOfBounds();
-	}
+void ScreenBoundsComponent::setMargin(float margin)
+{
+	m_margin = margin;
+	refreshVolume();
 }
 
-bool ScreenBoundsComponent::checkBounds()
+void ScreenBoundsComponent::refreshVolume()
 {
-	if (!m_owner || !m_owner->getLevel()) return false;
+	if (m_volumeSlot >= 0 && m_owner->getLevel()) {
+		m_owner->getLevel()->getPhysicsWorld()->refreshBoundsVolume(this);
+	}
+}
 
-	auto transform = m_owner->getTransform();
+Vector4D ScreenBoundsComponent::getInBoundsRegion() const
+{
 	auto sprite = m_owner->getComponent<SpriteComponent>();
-	if (!transform || !sprite) return false;
-
-	auto pos = transform->getPosition();
-	float width = sprite->getFrameWidth();
-	float height = sprite->getFrameHeight();
+	float width = sprite ? static_cast<float>(sprite->getFrameWidth()) : 0.0f;
+	float height = sprite ? static_cast<float>(sprite->getFrameHeight()) : 0.0f;
 	float screenWidth = m_owner->getLevel()->getScreenWidth();
 	float screenHeight = m_owner->getLevel()->getScreenHeight();
 
-	// Check each enabled boundary
-	bool outOfBounds = false;
+	// Unchecked sides are open
+	const float open = 1.0e6f;
+	float left = m_flags.checkLeft ? -m_margin - width : -open;
+	float right = m_flags.checkRight ? screenWidth + m_margin : open;
+	float top = m_flags.checkTop ? -m_margin - height : -open;
+	float bottom = m_flags.checkBottom ? screenHeight + m_margin : open;
 
-	if (m_flags.checkTop) {
-		outOfBounds |= (pos.y + height < -m_margin);
-	}
-	if (m_flags.checkBottom) {
-		outOfBounds |= (pos.y > screenHeight + m_margin);
-	}
-	if (m_flags.checkLeft) {
-		outOfBounds |= (pos.x + width < -m_margin);
-	}
-	if (m_flags.checkRight) {
-		outOfBounds |= (pos.x > screenWidth + m_margin);
-	}
-
-	m_isOutOfBounds = outOfBounds;
-	return outOfBounds;
+	return Vector4D(left, top, right - left, bottom - top);
 }
 
-void ScreenBoundsComponent::handleOutOfBounds()
+void ScreenBoundsComponent::onExit()
 {
+	m_isOutOfBounds = true;
+
 	//E2_LOG(Log, "Handle out of bounds called");
 	switch (m_behavior)
 	{
@@ -95,13 +85,16 @@ void ScreenBoundsComponent::handleOutOfBounds()
 	case BoundaryBehavior::SLEEP:
 		if (!m_isSleeping) {
 			m_isSleeping = true;
-			// Disable physics if present
+			// Stays where it is, out of the simulation, until it is moved back inside
 			if (auto physics = m_owner->getComponent<PhysicsComponent>()) {
 				physics->setVelocity(Vector2D(0.0f, 0.0f));
 			}
 			if (m_responder) {
 				m_responder->onBoundsSleep();
 			}
+			if (m_owner->getLevel() && !m_owner->isPendingRemoval()) {
+				m_owner->getLevel()->makeDormant(m_owner);
+			}
 			//E2_LOG(Log, "GameObject put to sleep due to being out of bounds");
 		}
 		break;
@@ -112,14 +105,18 @@ void ScreenBoundsComponent::handleOutOfBounds()
 	}
 }
 
-void ScreenBoundsComponent::wakeUp()
+void ScreenBoundsComponent::onEnter()
 {
+	m_isOutOfBounds = false;
+
 	if (m_isSleeping) {
 		m_isSleeping = false;
-		m_isOutOfBounds = false;
+		if (m_owner->getLevel()) {
+			m_owner->getLevel()->wakeObject(m_owner);
+		}
 		if (m_responder) {
 			m_responder->onBoundsWakeup();
 		}
 		//E2_LOG(Log, "GameObject woken up after returning to bounds");
 	}
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 #include "Core.h"
 #include "Component.h"
 #include "Vector2D.h"
+#include "Vector4D.h"
 #include "IBoundsResponder.h"
 
 class ENGINE2000_API ScreenBoundsComponent : public Component {
@@ -29,23 +30,35 @@ private:
 	bool m_isOutOfBounds;
 	bool m_isSleeping;
 	IBoundsResponder* m_responder;
+	int m_volumeSlot;	// Index in PhysicsWorld's bounds volumes, -1 while not in a level
+
+	friend class PhysicsWorld;
 
 public:
+	// No per-frame work: while the owner is in a level, PhysicsWorld::updateBounds tests
+	// it with every other bounds volume and calls back only when it leaves or re-enters
 	ScreenBoundsComponent(GameObject* owner);
 	virtual void init() override;
-	virtual void update(float deltaTime) override;
 
 	// Configuration
 	void setBehavior(BoundaryBehavior behavior) { m_behavior = behavior; }
-	void setBoundaryFlags(const BoundaryFlags& flags) { m_flags = flags; }
-	void setMargin(float margin) { m_margin = margin; }
+	void setBoundaryFlags(const BoundaryFlags& flags);
+	void setMargin(float margin);
 
 	// Status checks
 	bool isOutOfBounds() const { return m_isOutOfBounds; }
 	bool isSleeping() const { return m_isSleeping; }
 
+	// Back to the in-bounds, awake state; for objects reused from a pool
+	void reset() { m_isOutOfBounds = false; m_isSleeping = false; }
+
+	// Recomputes the region PhysicsWorld tests; the flags, the margin and the
+	// sprite's frame size (SpriteComponent calls it when that changes) feed it
+	void refreshVolume();
+
 private:
-	bool checkBounds();
-	void handleOutOfBounds();
-	void wakeUp();
+	// Where the owner's position may be without being out of bounds
+	Vector4D getInBoundsRegion() const;
+	void onExit();
+	void onEnter();
 };
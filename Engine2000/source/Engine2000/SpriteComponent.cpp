@@ -2,6 +2,8 @@
 #include "GameObject.h"
 #include "TransformComponent.h"
 #include "Texture.h"
+#include "Renderer.h"
+#include "ScreenBoundsComponent.h"
 
 #include <SDL2/SDL.h>
 
@@ -52,6 +54,8 @@ void SpriteComponent::setTexture(const char* filePath)
 	m_isAnimated = false;
 	m_animMode = STATIC;
 	m_totalFrames = 1;
+
+	onFrameSizeChanged();
 }
 
 void SpriteComponent::setAnimatedTexture(const char* filePath, int horizontalFrames, int verticalFrames)
@@ -79,6 +83,8 @@ void SpriteComponent::setAnimatedTexture(const char* filePath, int horizontalFra
 	m_endFrame = m_totalFrames - 1;
 	m_hasFrameRange = false;
 	m_currentFrame = 0;
+
+	onFrameSizeChanged();
 }
 
 void SpriteComponent::setAnimationMode(AnimationMode mode)
@@ -148,6 +154,11 @@ void SpriteComponent::render()
 {
 	if (!m_texture || !m_isVisible) return;
 
+	// Blend between the last two simulation steps
+	Vector2D pos = m_owner->getTransform()->getInterpolatedPosition(Renderer::Instance().getInterpolationAlpha());
+	m_positionRect.x = pos.x;
+	m_positionRect.y = pos.y;
+
 	// Apply transform scale
 	const Vector2D& scale = m_owner->getTransform()->getScale();
 	m_positionRect.w = m_frameRect.w * scale.x;
@@ -184,4 +195,14 @@ void SpriteComponent::setCustomFrameRect(int x, int y, int width, int height)
 	m_frameRect.y = y;
 	m_frameRect.w = width;
 	m_frameRect.h = height;
+
+	onFrameSizeChanged();
+}
+
+void SpriteComponent::onFrameSizeChanged()
+{
+	if (auto bounds = m_owner->getComponent<ScreenBoundsComponent>())
+	{
+		bounds->refreshVolume();
+	}
 }
@@ -52,6 +52,9 @@ private:
 	Vector4D m_customFrameRect;
 	bool m_useCustomFrameRect;
 
+	// The owner's screen bounds region is sized by the frame
+	void onFrameSizeChanged();
+
 public:
 	SpriteComponent(GameObject* owner);
 	~SpriteComponent();
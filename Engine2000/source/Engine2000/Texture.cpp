@@ -1,13 +1,11 @@
 #include "Texture.h"
 #include "Renderer.h"
+#include "TextureCache.h"
 #include "EngineError.h"
 #include "E2Log.h"
 
 #include <glad/glad.h>
-#include <unordered_map>
-#include <memory>
-#include <string>
-#include "stb_image.h"
+#include <utility>
 
 class Texture::TextureImpl
 {
@@ -16,109 +14,56 @@ private:
 	int m_width;
 	int m_height;
 	bool m_useOpenGL;
+	bool m_headless;
+
+	// Shared GPU texture, owned by the cache
+	TextureHandle m_resource;
 
 	// SDL2 specific members
-	std::shared_ptr<SDL_Texture> m_sdlTexture;
 	SDL_Renderer* m_sdlRenderer;
 
 	// OpenGL specific members
 	GLuint m_glTextureId;
 
-	// Shared texture cache for both backends
-	static std::unordered_map<std::string, std::shared_ptr<void>> s_textureCache;
-
 public:
 	TextureImpl()
 		: m_width(0)
 		, m_height(0)
 		, m_useOpenGL(false)
-		, m_sdlTexture(nullptr)
+		, m_headless(false)
 		, m_sdlRenderer(nullptr)
 		, m_glTextureId(0)
 	{
 		// Check renderer type
 		m_useOpenGL = Renderer::Instance().isOpenGL();
-		if (!m_useOpenGL)
+		m_headless = Renderer::Instance().isHeadless();
+		if (!m_useOpenGL && !m_headless)
 		{
 			m_sdlRenderer = static_cast<SDL_Renderer*>(Renderer::Instance().getRenderer());
 		}
 	}
 
-	~TextureImpl()
-	{
-		if (m_useOpenGL && m_glTextureId)
-		{
-			glDeleteTextures(1, &m_glTextureId);
-		}
-	}
-
 	void* loadFromFile(const char* filePath)
 	{
-		std::string path(filePath);
-
-		// Check cache first
-		auto it = s_textureCache.find(path);
-		if (it != s_textureCache.end())
-		{
-			if (m_useOpenGL)
-			{
-				m_glTextureId = *static_cast<GLuint*>(it->second.get());
-				return &m_glTextureId;
-			}
-			m_sdlTexture = std::static_pointer_cast<SDL_Texture>(it->second);
-			return m_sdlTexture.get();
-		}
-
-		SDL_Surface* surface = nullptr;
+		// Replacing the handle releases the previous texture if nobody else uses it
+		m_resource = TextureCache::Instance().acquire(filePath);
 
-		// Get file extension
-		std::string ext = path.substr(path.find_last_of(".") + 1);
+		m_width = m_resource->width;
+		m_height = m_resource->height;
+		m_glTextureId = m_resource->glTextureId;
 
-		// Load based on file type
-		if (ext == "bmp" || ext == "BMP")
-		{
-			surface = SDL_LoadBMP(filePath);
-			if (surface && SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 0, 255)) < 0)
-			{
-				SDL_FreeSurface(surface);
-				throw EngineError("Failed to set color key");
-			}
-		}
-		else
-		{
-			// For PNG, JPG, TGA
-			int width, height, channels;
-			stbi_set_flip_vertically_on_load(m_useOpenGL);
-			unsigned char* data = stbi_load(filePath, &width, &height, &channels, 4); // Force RGBA
-
-			if (data)
-			{
-				surface = SDL_CreateRGBSurface(0, width, height, 32,
-					0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
-
-				if (surface)
-				{
-					SDL_LockSurface(surface);
-					memcpy(surface->pixels, data, width * height * 4);
-					SDL_UnlockSurface(surface);
-				}
-				stbi_image_free(data);
-			}
-		}
-
-		if (!surface) throw EngineError("Failed to load image");
-
-		m_width = surface->w;
-		m_height = surface->h;
-
-		void* result = m_useOpenGL ? createGLTexture(surface) : createSDLTexture(surface);
-		SDL_FreeSurface(surface);
-		return result;
+		return getTexture();
 	}
 
 	void draw(const Vector4D& srcRect, const Vector4D& dstRect, SDL_RendererFlip flip)
 	{
-		if (m_useOpenGL)
+		if (!m_resource) return;
+
+		if (m_headless)
+		{
+			Renderer::Instance().drawNull();
+		}
+		else if (m_useOpenGL)
 		{
 			drawWithOpenGL(srcRect, dstRect, flip);
 		}
@@ -129,68 +74,15 @@ public:
 	}
 
 private:
-	void* createGLTexture(SDL_Surface* surface)
-	{
-		GLuint textureId;
-		glGenTextures(1, &textureId);
-		glBindTexture(GL_TEXTURE_2D, textureId);
-
-		// Log texture creation
-// 		E2_LOG(Log, "Creating GL texture %u from surface %dx%d",
-// 			textureId, surface->w, surface->h);
-
-		// Set texture parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-		// Convert surface to RGBA format if needed
-		SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface,
-			SDL_PIXELFORMAT_RGBA32, 0);
-
-		if (!rgbaSurface) {
-			E2_LOG(Error, "Failed to convert surface to RGBA");
-			return nullptr;
-		}
-
-		// Upload texture data
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-			rgbaSurface->w, rgbaSurface->h, 0,
-			GL_RGBA, GL_UNSIGNED_BYTE, rgbaSurface->pixels);
-
-		GLenum error = glGetError();
-		if (error != GL_NO_ERROR) {
-			E2_LOG(Error, "Error creating texture: %d", error);
-		}
-
-		SDL_FreeSurface(rgbaSurface);
-
-		m_glTextureId = textureId;
-		return &m_glTextureId;
-	}
-
-	void* createSDLTexture(SDL_Surface* surface)
-	{
-		SDL_Texture* newTexture = SDL_CreateTextureFromSurface(m_sdlRenderer, surface);
-		if (!newTexture)
-		{
-			throw EngineError();
-		}
-
-		m_sdlTexture = std::shared_ptr<SDL_Texture>(newTexture, SDL_DestroyTexture);
-		s_textureCache[std::to_string(surface->w)] = m_sdlTexture;
-
-		return m_sdlTexture.get();
-	}
-
 	void drawWithOpenGL(const Vector4D& srcRect, const Vector4D& dstRect, SDL_RendererFlip flip)
 	{
-		// Calculate normalized texture coordinates
-		float texLeft = srcRect.x / static_cast<float>(m_width);
-		float texRight = (srcRect.x + srcRect.w) / static_cast<float>(m_width);
-		float texTop = srcRect.y / static_cast<float>(m_height);
-		float texBottom = (srcRect.y + srcRect.h) / static_cast<float>(m_height);
+		// Calculate normalized texture coordinates; atlas sprites are offset into their page
+		float pageWidth = static_cast<float>(m_resource->pageWidth);
+		float pageHeight = static_cast<float>(m_resource->pageHeight);
+		float texLeft = (m_resource->atlasX + srcRect.x) / pageWidth;
+		float texRight = (m_resource->atlasX + srcRect.x + srcRect.w) / pageWidth;
+		float texTop = (m_resource->atlasY + srcRect.y) / pageHeight;
+		float texBottom = (m_resource->atlasY + srcRect.y + srcRect.h) / pageHeight;
 
 		if (flip & SDL_FLIP_HORIZONTAL)
 		{
@@ -225,23 +117,22 @@ private:
 			static_cast<int>(dstRect.h)
 		};
 
-		SDL_RenderCopyEx(m_sdlRenderer, m_sdlTexture.get(),
+		SDL_RenderCopyEx(m_sdlRenderer, m_resource->sdlTexture,
 			&sdlSrcRect, &sdlDstRect, 0.0, nullptr, flip);
 	}
 
 public:
 	void* getTexture() const
 	{
-		return m_useOpenGL ? (void*)&m_glTextureId : (void*)m_sdlTexture.get();
+		if (!m_resource) return nullptr;
+		if (m_headless) return m_resource.get();	// Metadata only, no GPU object
+		return m_useOpenGL ? (void*)&m_glTextureId : (void*)m_resource->sdlTexture;
 	}
 
 	int getWidth() const { return m_width; }
 	int getHeight() const { return m_height; }
 };
 
-// Initialize static member
-std::unordered_map<std::string, std::shared_ptr<void>> Texture::TextureImpl::s_textureCache;
-
 // Texture.cpp - Implementation of public methods
 Texture::Texture() : pimpl(new TextureImpl()) {}
 Texture::~Texture() { delete pimpl; }
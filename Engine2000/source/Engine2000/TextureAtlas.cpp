@@ -0,0 +1,395 @@
+#include "TextureAtlas.h"
+#include "TextureCache.h"
+#include "Renderer.h"
+#include "E2Log.h"
+
+#include <SDL2/SDL.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class TextureAtlas::TextureAtlasImpl
+{
+private:
+	struct SkylineNode
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	struct Page
+	{
+		GLuint textureId;
+		std::vector<uint32_t> pixels;		// RGBA32, only kept while building
+		std::vector<SkylineNode> skyline;
+	};
+
+	struct PendingImage
+	{
+		std::string path;
+		SDL_Surface* surface;
+	};
+
+	std::vector<std::string> m_registered;
+	std::unordered_map<std::string, AtlasRegion> m_regions;	// Keyed by normalised path
+	std::vector<Page> m_pages;
+	AtlasStats m_stats;
+	bool m_isBuilt;
+
+	int m_pageSize;
+	int m_padding;
+
+public:
+	TextureAtlasImpl()
+		: m_isBuilt(false)
+		, m_pageSize(2048)
+		, m_padding(1)
+	{}
+
+	~TextureAtlasImpl()
+	{
+		// GL objects are released through clear() while the context is alive
+	}
+
+	// Windows paths are case-insensitive and code refers to "graphics/font8x8.bmp" as well as "Font8x8.bmp"
+	static std::string normalisePath(const std::string& path)
+	{
+		std::string key = path;
+		for (char& c : key)
+		{
+			c = (c == '\\') ? '/' : static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+		}
+		return key;
+	}
+
+	void registerImage(const char* filePath)
+	{
+		if (m_isBuilt)
+		{
+			E2_LOG(Warning, "Atlas already built, %s will load as a standalone texture", filePath);
+			return;
+		}
+		m_registered.push_back(filePath);
+	}
+
+	void registerDirectory(const char* directory)
+	{
+		namespace fs = std::filesystem;
+
+		std::error_code error;
+		if (!fs::is_directory(directory, error))
+		{
+			E2_LOG(Warning, "Atlas directory not found: %s", directory);
+			return;
+		}
+
+		for (const auto& entry : fs::directory_iterator(directory, error))
+		{
+			if (!entry.is_regular_file()) continue;
+
+			std::string ext = normalisePath(entry.path().extension().string());
+			if (ext != ".bmp" && ext != ".png" && ext != ".jpg" && ext != ".tga") continue;
+
+			registerImage((std::string(directory) + "/" + entry.path().filename().string()).c_str());
+		}
+	}
+
+	void build(int pageSize, int padding)
+	{
+		if (m_isBuilt || m_registered.empty()) return;
+
+		if (!Renderer::Instance().isOpenGL())
+		{
+			E2_LOG(Log, "Texture atlas skipped (SDL2 backend)");
+			return;
+		}
+
+		GLint maxTextureSize = 0;
+		glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+		m_pageSize = maxTextureSize > 0 ? std::min(pageSize, static_cast<int>(maxTextureSize)) : pageSize;
+		m_padding = padding;
+
+		// Decode everything up front so images can be packed tallest first
+		std::vector<PendingImage> images;
+		images.reserve(m_registered.size());
+		for (const std::string& path : m_registered)
+		{
+			SDL_Surface* surface = nullptr;
+			try
+			{
+				surface = TextureCache::Instance().loadSurface(path);
+			}
+			catch (...)
+			{
+				E2_LOG(Warning, "Atlas failed to load %s", path.c_str());
+				continue;
+			}
+
+			SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+			SDL_FreeSurface(surface);
+			if (rgbaSurface)
+			{
+				images.push_back({ path, rgbaSurface });
+			}
+		}
+
+		std::stable_sort(images.begin(), images.end(), [](const PendingImage& a, const PendingImage& b) {
+			return a.surface->h > b.surface->h;
+		});
+
+		size_t packedArea = 0;
+		for (PendingImage& image : images)
+		{
+			int width = image.surface->w;
+			int height = image.surface->h;
+
+			AtlasRegion region;
+			if (width <= m_pageSize && height <= m_pageSize && place(width, height, region))
+			{
+				copyPixels(m_pages[region.pageTexture], image.surface, region.x, region.y);
+				m_regions[normalisePath(image.path)] = region;
+				packedArea += static_cast<size_t>(width) * height;
+				m_stats.images++;
+			}
+			else
+			{
+				m_stats.skipped++;
+			}
+			SDL_FreeSurface(image.surface);
+		}
+
+		upload();
+
+		m_stats.pages = static_cast<int>(m_pages.size());
+		size_t pageArea = static_cast<size_t>(m_pageSize) * m_pageSize * m_pages.size();
+		m_stats.efficiency = pageArea ? static_cast<float>(packedArea) / pageArea : 0.0f;
+		m_isBuilt = true;
+
+		E2_LOG(Log, "Texture atlas built: %d images in %d page(s) of %dx%d, %.1f%% efficiency, %d skipped",
+			m_stats.images, m_stats.pages, m_pageSize, m_pageSize, m_stats.efficiency * 100.0f, m_stats.skipped);
+	}
+
+	void clear()
+	{
+		for (Page& page : m_pages)
+		{
+			if (page.textureId)
+			{
+				glDeleteTextures(1, &page.textureId);
+			}
+		}
+		m_pages.clear();
+		m_regions.clear();
+		m_registered.clear();
+		m_stats = AtlasStats();
+		m_isBuilt = false;
+	}
+
+	bool isBuilt() const { return m_isBuilt; }
+
+	bool findRegion(const char* filePath, AtlasRegion& outRegion) const
+	{
+		if (!m_isBuilt) return false;
+
+		auto it = m_regions.find(normalisePath(filePath));
+		if (it == m_regions.end()) return false;
+
+		outRegion = it->second;
+		outRegion.pageTexture = m_pages[it->second.pageTexture].textureId;
+		return true;
+	}
+
+	const AtlasStats& getStats() const { return m_stats; }
+
+private:
+	// Stores the page index in region.pageTexture until upload() replaces it with the GL id
+	bool place(int width, int height, AtlasRegion& region)
+	{
+		for (size_t i = 0; i < m_pages.size(); ++i)
+		{
+			if (placeInPage(m_pages[i], width, height, region))
+			{
+				region.pageTexture = static_cast<unsigned int>(i);
+				return true;
+			}
+		}
+
+		Page page;
+		page.textureId = 0;
+		page.pixels.assign(static_cast<size_t>(m_pageSize) * m_pageSize, 0);
+		page.skyline.push_back({ 0, 0, m_pageSize });
+		m_pages.push_back(std::move(page));
+
+		if (placeInPage(m_pages.back(), width, height, region))
+		{
+			region.pageTexture = static_cast<unsigned int>(m_pages.size() - 1);
+			return true;
+		}
+		return false;
+	}
+
+	// Padded span an image of this width covers when placed at x
+	int spanAt(int x, int width) const
+	{
+		return std::min(width + m_padding, m_pageSize - x);
+	}
+
+	// Height of the skyline under the padded span starting at a node, or -1 if it does not fit
+	int fitAt(const Page& page, size_t nodeIndex, int width, int height) const
+	{
+		int x = page.skyline[nodeIndex].x;
+		if (x + width > m_pageSize) return -1;
+
+		int y = 0;
+		int remaining = spanAt(x, width);
+		for (size_t i = nodeIndex; remaining > 0; ++i)
+		{
+			if (i >= page.skyline.size()) return -1;
+			y = std::max(y, page.skyline[i].y);
+			if (y + height > m_pageSize) return -1;
+			remaining -= page.skyline[i].width;
+		}
+		return y;
+	}
+
+	bool placeInPage(Page& page, int width, int height, AtlasRegion& region)
+	{
+		// Padding is reserved to the right and below, clipped at the page edge
+		int paddedHeight = height + m_padding;
+
+		int bestIndex = -1;
+		int bestBottom = m_pageSize + 1;
+		int bestWidth = m_pageSize + 1;
+		int bestY = 0;
+
+		for (size_t i = 0; i < page.skyline.size(); ++i)
+		{
+			int y = fitAt(page, i, width, height);
+			if (y < 0) continue;
+
+			// Bottom-left rule: lowest resulting top edge, then narrowest segment
+			int bottom = y + height;
+			if (bottom < bestBottom || (bottom == bestBottom && page.skyline[i].width < bestWidth))
+			{
+				bestIndex = static_cast<int>(i);
+				bestBottom = bottom;
+				bestWidth = page.skyline[i].width;
+				bestY = y;
+			}
+		}
+
+		if (bestIndex < 0) return false;
+
+		region.x = page.skyline[bestIndex].x;
+		region.y = bestY;
+		region.width = width;
+		region.height = height;
+		region.pageWidth = m_pageSize;
+		region.pageHeight = m_pageSize;
+
+		// Raise the skyline over the new rectangle
+		SkylineNode node = { region.x, bestY + paddedHeight, spanAt(region.x, width) };
+		page.skyline.insert(page.skyline.begin() + bestIndex, node);
+
+		for (size_t i = bestIndex + 1; i < page.skyline.size(); )
+		{
+			SkylineNode& previous = page.skyline[i - 1];
+			SkylineNode& current = page.skyline[i];
+			int overlap = previous.x + previous.width - current.x;
+			if (overlap <= 0) break;
+
+			current.x += overlap;
+			current.width -= overlap;
+			if (current.width <= 0)
+			{
+				page.skyline.erase(page.skyline.begin() + i);
+				continue;
+			}
+			break;
+		}
+
+		// Merge neighbours at the same height
+		for (size_t i = 0; i + 1 < page.skyline.size(); )
+		{
+			if (page.skyline[i].y == page.skyline[i + 1].y)
+			{
+				page.skyline[i].width += page.skyline[i + 1].width;
+				page.skyline.erase(page.skyline.begin() + i + 1);
+				continue;
+			}
+			++i;
+		}
+
+		return true;
+	}
+
+	void copyPixels(Page& page, SDL_Surface* surface, int x, int y)
+	{
+		SDL_LockSurface(surface);
+		const uint8_t* source = static_cast<const uint8_t*>(surface->pixels);
+		for (int row = 0; row < surface->h; ++row)
+		{
+			uint32_t* destination = page.pixels.data() + static_cast<size_t>(y + row) * m_pageSize + x;
+			memcpy(destination, source + static_cast<size_t>(row) * surface->pitch, surface->w * 4);
+		}
+		SDL_UnlockSurface(surface);
+	}
+
+	void upload()
+	{
+		for (Page& page : m_pages)
+		{
+			glGenTextures(1, &page.textureId);
+			glBindTexture(GL_TEXTURE_2D, page.textureId);
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_pageSize, m_pageSize, 0,
+				GL_RGBA, GL_UNSIGNED_BYTE, page.pixels.data());
+
+			GLenum error = glGetError();
+			if (error != GL_NO_ERROR) {
+				E2_LOG(Error, "Error uploading atlas page: %d", error);
+			}
+
+			// CPU copy is no longer needed
+			std::vector<uint32_t>().swap(page.pixels);
+		}
+		glBindTexture(GL_TEXTURE_2D, 0);
+	}
+};
+
+TextureAtlas& TextureAtlas::Instance()
+{
+	static TextureAtlas instance;
+	return instance;
+}
+
+TextureAtlas::TextureAtlas() : pimpl(new TextureAtlasImpl()) {}
+TextureAtlas::~TextureAtlas() { delete pimpl; }
+
+void TextureAtlas::registerImage(const char* filePath) { pimpl->registerImage(filePath); }
+
+void TextureAtlas::registerDirectory(const char* directory) { pimpl->registerDirectory(directory); }
+
+void TextureAtlas::build(int pageSize, int padding) { pimpl->build(pageSize, padding); }
+
+void TextureAtlas::clear() { pimpl->clear(); }
+
+bool TextureAtlas::isBuilt() const { return pimpl->isBuilt(); }
+
+bool TextureAtlas::findRegion(const char* filePath, AtlasRegion& outRegion) const
+{
+	return pimpl->findRegion(filePath, outRegion);
+}
+
+const AtlasStats& TextureAtlas::getStats() const { return pimpl->getStats(); }
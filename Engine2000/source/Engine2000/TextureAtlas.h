@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Core.h"
+
+// Where a packed image lives inside an atlas page (pixels)
+struct AtlasRegion
+{
+	unsigned int pageTexture = 0;
+	int x = 0;
+	int y = 0;
+	int width = 0;
+	int height = 0;
+	int pageWidth = 0;
+	int pageHeight = 0;
+};
+
+struct AtlasStats
+{
+	int images = 0;			// Images packed into pages
+	int skipped = 0;		// Images too large for a page, left as standalone textures
+	int pages = 0;
+	float efficiency = 0.0f;	// Packed pixel area / total page area
+};
+
+// Packs registered images into a few large OpenGL textures so the sprite
+// batch can draw sprites from different sheets without switching textures.
+// Images are registered and built once at level load; TextureCache then
+// resolves any packed path to its page and sub-rectangle.
+class ENGINE2000_API TextureAtlas {
+private:
+	// Singleton pattern
+	TextureAtlas();
+	~TextureAtlas();
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	class TextureAtlasImpl;
+	TextureAtlasImpl* pimpl;
+
+public:
+	static TextureAtlas& Instance();
+
+	// Registration, only honoured before build()
+	void registerImage(const char* filePath);
+	void registerDirectory(const char* directory);
+
+	// Packs every registered image (skyline, bottom-left). No-op for the SDL2 backend
+	// or when the atlas is already built.
+	void build(int pageSize = 2048, int padding = 1);
+	void clear();
+	bool isBuilt() const;
+
+	bool findRegion(const char* filePath, AtlasRegion& outRegion) const;
+
+	const AtlasStats& getStats() const;
+};
@@ -0,0 +1,228 @@
+#include "TextureCache.h"
+#include "TextureAtlas.h"
+#include "Renderer.h"
+#include "EngineError.h"
+#include "E2Log.h"
+#include "Platform.h"
+#include "Profiler.h"
+
+#include <SDL2/SDL.h>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include "stb_image.h"
+
+TextureCache& TextureCache::Instance()
+{
+	static TextureCache instance;
+	return instance;
+}
+
+TextureHandle TextureCache::acquire(const char* filePath)
+{
+	std::string path(filePath);
+
+	// Check cache first
+	auto it = m_entries.find(path);
+	if (it != m_entries.end())
+	{
+		if (TextureHandle handle = it->second.lock())
+		{
+			m_stats.hits++;
+			return handle;
+		}
+	}
+
+	m_stats.misses++;
+	E2_PROFILE_SCOPE("TextureCache::load");
+
+	// Packed images share their atlas page instead of getting their own texture
+	AtlasRegion region;
+	if (TextureAtlas::Instance().findRegion(filePath, region))
+	{
+		TextureResource* resource = new TextureResource();
+		resource->path = path;
+		resource->width = region.width;
+		resource->height = region.height;
+		resource->glTextureId = region.pageTexture;
+		resource->atlasX = region.x;
+		resource->atlasY = region.y;
+		resource->pageWidth = region.pageWidth;
+		resource->pageHeight = region.pageHeight;
+		resource->ownsTexture = false;
+
+		m_stats.atlasResolves++;
+		m_stats.liveTextures++;
+
+		TextureHandle handle(resource, [this](TextureResource* r) { release(r); });
+		m_entries[path] = handle;
+		return handle;
+	}
+
+	SDL_Surface* surface = loadSurface(path);
+
+	TextureResource* resource = new TextureResource();
+	resource->path = path;
+	resource->width = surface->w;
+	resource->height = surface->h;
+	resource->pageWidth = surface->w;
+	resource->pageHeight = surface->h;
+
+	try
+	{
+		upload(resource, surface);
+	}
+	catch (...)
+	{
+		SDL_FreeSurface(surface);
+		delete resource;
+		throw;
+	}
+	SDL_FreeSurface(surface);
+
+	m_stats.liveTextures++;
+	m_stats.liveBytes += resource->bytes;
+	m_stats.peakBytes = std::max(m_stats.peakBytes, m_stats.liveBytes);
+
+	// The deleter runs when the last Texture using this path lets go
+	TextureHandle handle(resource, [this](TextureResource* r) { release(r); });
+	m_entries[path] = handle;
+	return handle;
+}
+
+SDL_Surface* TextureCache::loadSurface(const std::string& path)
+{
+	SDL_Surface* surface = nullptr;
+
+	// Asset names in code do not always match the on-disk case
+	const std::string diskPath = Platform::resolvePath(path);
+
+	// Get file extension
+	std::string ext = path.substr(path.find_last_of(".") + 1);
+
+	// Load based on file type
+	if (ext == "bmp" || ext == "BMP")
+	{
+		surface = SDL_LoadBMP(diskPath.c_str());
+		if (surface && SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 255, 0, 255)) < 0)
+		{
+			SDL_FreeSurface(surface);
+			throw EngineError("Failed to set color key");
+		}
+	}
+	else
+	{
+		// For PNG, JPG, TGA
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(Renderer::Instance().isOpenGL());
+		unsigned char* data = stbi_load(diskPath.c_str(), &width, &height, &channels, 4); // Force RGBA
+
+		if (data)
+		{
+			surface = SDL_CreateRGBSurface(0, width, height, 32,
+				0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+
+			if (surface)
+			{
+				SDL_LockSurface(surface);
+				memcpy(surface->pixels, data, width * height * 4);
+				SDL_UnlockSurface(surface);
+			}
+			stbi_image_free(data);
+		}
+	}
+
+	if (!surface)
+	{
+		E2_LOG(Error, "Failed to load image: %s", path.c_str());
+		throw EngineError("Failed to load image");
+	}
+
+	return surface;
+}
+
+void TextureCache::upload(TextureResource* resource, SDL_Surface* surface)
+{
+	resource->bytes = static_cast<size_t>(surface->w) * surface->h * 4;
+
+	if (Renderer::Instance().isHeadless())
+	{
+		// Nothing to upload; size and path are all the null backend needs
+		return;
+	}
+
+	if (Renderer::Instance().isOpenGL())
+	{
+		// Convert surface to RGBA format if needed
+		SDL_Surface* rgbaSurface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+		if (!rgbaSurface)
+		{
+			throw EngineError("Failed to convert surface to RGBA");
+		}
+
+		GLuint textureId;
+		glGenTextures(1, &textureId);
+		glBindTexture(GL_TEXTURE_2D, textureId);
+
+		// Set texture parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		// Upload texture data
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+			rgbaSurface->w, rgbaSurface->h, 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, rgbaSurface->pixels);
+
+		GLenum error = glGetError();
+		if (error != GL_NO_ERROR) {
+			E2_LOG(Error, "Error creating texture: %d", error);
+		}
+
+		glBindTexture(GL_TEXTURE_2D, 0);
+		SDL_FreeSurface(rgbaSurface);
+
+		resource->glTextureId = textureId;
+	}
+	else
+	{
+		auto renderer = static_cast<SDL_Renderer*>(Renderer::Instance().getRenderer());
+		resource->sdlTexture = SDL_CreateTextureFromSurface(renderer, surface);
+		if (!resource->sdlTexture)
+		{
+			throw EngineError();
+		}
+	}
+}
+
+void TextureCache::release(TextureResource* resource)
+{
+	if (resource->glTextureId && resource->ownsTexture)
+	{
+		glDeleteTextures(1, &resource->glTextureId);
+	}
+	if (resource->sdlTexture)
+	{
+		SDL_DestroyTexture(resource->sdlTexture);
+	}
+
+	m_stats.liveTextures--;
+	m_stats.liveBytes -= resource->bytes;
+
+	// Only drop the entry if nobody has reloaded the path since
+	auto it = m_entries.find(resource->path);
+	if (it != m_entries.end() && it->second.expired())
+	{
+		m_entries.erase(it);
+	}
+
+	delete resource;
+}
+
+void TextureCache::logStats() const
+{
+	E2_LOG(Log, "Texture cache: %d hits, %d misses (%d from atlas), %d live textures (%zu KB, peak %zu KB)",
+		m_stats.hits, m_stats.misses, m_stats.atlasResolves, m_stats.liveTextures,
+		m_stats.liveBytes / 1024, m_stats.peakBytes / 1024);
+}
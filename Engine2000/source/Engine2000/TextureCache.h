@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+struct SDL_Surface;
+struct SDL_Texture;
+
+// One decoded image living on the GPU, shared by every Texture that loads the same path
+struct TextureResource
+{
+	std::string path;
+	int width = 0;
+	int height = 0;
+	unsigned int glTextureId = 0;		// OpenGL backend
+	SDL_Texture* sdlTexture = nullptr;	// SDL2 backend
+	size_t bytes = 0;					// Approximate GPU memory (RGBA8)
+
+	// Sub-rectangle inside the GL texture; differs from (0, 0, width, height) for atlas pages
+	int atlasX = 0;
+	int atlasY = 0;
+	int pageWidth = 0;
+	int pageHeight = 0;
+	bool ownsTexture = true;			// Atlas pages are owned by TextureAtlas
+};
+
+using TextureHandle = std::shared_ptr<TextureResource>;
+
+struct TextureCacheStats
+{
+	int hits = 0;
+	int misses = 0;
+	int atlasResolves = 0;		// Misses served from an atlas page, without decoding
+	int liveTextures = 0;
+	size_t liveBytes = 0;
+	size_t peakBytes = 0;
+};
+
+// Path keyed asset cache. Handles are ref-counted; the GPU texture is
+// released when the last handle for a path goes away.
+class TextureCache {
+private:
+	// Singleton pattern
+	TextureCache() = default;
+	~TextureCache() = default;
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	std::unordered_map<std::string, std::weak_ptr<TextureResource>> m_entries;
+	TextureCacheStats m_stats;
+
+	void upload(TextureResource* resource, SDL_Surface* surface);
+	void release(TextureResource* resource);
+
+public:
+	static TextureCache& Instance();
+
+	// Returns the shared texture for filePath, loading it on a miss. Throws EngineError on failure.
+	TextureHandle acquire(const char* filePath);
+
+	// Decodes an image file (BMPs get the magenta colour key). Caller frees the surface.
+	SDL_Surface* loadSurface(const std::string& path);
+
+	const TextureCacheStats& getStats() const { return m_stats; }
+	void logStats() const;
+};
@@ -1,24 +1,34 @@
 #pragma once
 
 #include "Core.h"
+#include "Component.h"
 #include "Vector2D.h"
 
 class ENGINE2000_API TransformComponent : public Component 
 {
 private: 
 	Vector2D m_position;
+	Vector2D m_previousPosition;	// Position at the start of the current fixed step
 	Vector2D m_scale;
 
 public:
 	TransformComponent(GameObject* owner)
 		: Component(owner)
 		, m_position(0.0f, 0.0f)
+		, m_previousPosition(0.0f, 0.0f)
 		, m_scale(1.0f,1.0f) {}
 
 	void setPosition(float x, float y) { m_position = Vector2D(x,y); }
 	void setPosition(Vector2D position) { m_position = position; }
 	const Vector2D& getPosition() const { return m_position; }
 
+	// Render interpolation: snapshot once per fixed step, blend by the frame's alpha
+	void storePreviousPosition() { m_previousPosition = m_position; }
+	Vector2D getInterpolatedPosition(float alpha) const {
+		return Vector2D(m_previousPosition.x + (m_position.x - m_previousPosition.x) * alpha,
+			m_previousPosition.y + (m_position.y - m_previousPosition.y) * alpha);
+	}
+
 	void setScale(float x, float y) { m_scale = Vector2D(x, y); }
 	void setScale(float uniform) { m_scale = Vector2D(uniform, uniform); }
 	const Vector2D& getScale() const { return m_scale; }
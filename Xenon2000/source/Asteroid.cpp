@@ -121,7 +121,8 @@ void Asteroid::takeDamage(float amount)
 		// Handle removal
 		if (auto xenonLevel = dynamic_cast<XenonLevel*>(m_level))
 		{
-			auto scorePopup = xenonLevel->createGameObject<TextDisplay>(false, true, 1.0f);
+			auto scorePopup = xenonLevel->acquireGameObject<TextDisplay>();
+			scorePopup->setTemporary(1.0f);
 			scorePopup->setPosition(getTransform()->getPosition());
 			scorePopup->setText(std::to_string(m_scoreValue));
 			xenonLevel->addScore(m_scoreValue);
@@ -9,7 +9,7 @@ const float Companion::DAMAGE_DISPLAY_DURATION = 0.25f;
 const float Companion::DEATH_FRAME_TIME = 0.1f;
 
 Companion::Companion(Player* player, bool isLeftSide, float projectileSpeed)
-	: m_player(player)
+	: m_player(player->getHandle())
 	, m_projectileSpeed(projectileSpeed)
 	, m_isLeftSide(isLeftSide)
 	, m_horizontalOffset(50.0f)
@@ -70,10 +70,12 @@ void Companion::update(float deltaTime)
 		}
 	}
 
-	if (!m_player) return;
+	// Player may have been removed from the level
+	Player* player = getLevel()->resolve<Player>(m_player);
+	if (!player) return;
 
 	// Update position relative to player
-	updatePosition(deltaTime);
+	updatePosition(player, deltaTime);
 
 	GameObject::update(deltaTime);
 }
@@ -98,13 +100,13 @@ void Companion::updateDeathAnimation(float deltaTime)
 	}
 }
 
-void Companion::updatePosition(float deltaTime)
+void Companion::updatePosition(Player* player, float deltaTime)
 {
-	if (!m_player || !m_physics) return;
+	if (!player || !m_physics) return;
 
 	// Get player's position and dimensions
-	auto playerPos = m_player->getTransform()->getPosition();
-	auto playerSprite = m_player->getSprite();
+	auto playerPos = player->getTransform()->getPosition();
+	auto playerSprite = player->getSprite();
 	float playerWidth = playerSprite->getFrameWidth();
 	float playerHeight = playerSprite->getFrameHeight();
 
@@ -156,7 +158,8 @@ void Companion::shoot()
 {
 	if (!m_isAlive || !getLevel()) return;
 
-	auto projectile = getLevel()->createGameObject<PlayerProjectile>();
+	auto projectile = getLevel()->acquireGameObject<PlayerProjectile>();
+	projectile->setProjectileType(PlayerProjectile::ProjectileType::Light);
 	auto pos = getTransform()->getPosition();
 
 	float projectileX = pos.x + (m_sprite->getFrameWidth() * 0.5f);
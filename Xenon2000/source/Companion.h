@@ -19,7 +19,7 @@ class Companion : public GameObject, public IDamageable {
 private:
 	SpriteComponent* m_sprite;
 	PhysicsComponent* m_physics;
-	Player* m_player;
+	GameObjectHandle m_player;
 	float m_projectileSpeed;
 	bool m_isLeftSide;
 	float m_horizontalOffset;
@@ -59,7 +59,7 @@ public:
 	void upgradeWeapon();
 
 private:
-	void updatePosition(float deltaTime);
+	void updatePosition(Player* player, float deltaTime);
 	void updateDeathAnimation(float deltaTime);
 	void die();
 };
\ No newline at end of file
@@ -35,5 +35,8 @@ public:
 	virtual void update(float deltaTime) override;
 	virtual void onSensorBegin(GameObject* other) override;
 	void spawn(float x, float y, int phase);
+	// Catches the oscillation up with the time spent dormant before entering
+	virtual void onWake(float dormantSeconds) override { m_time += dormantSeconds; }
+	float getDescendSpeed() const { return m_descendSpeed * 60.0f; }	// Pixels per second
 	virtual void takeDamage(float amount) override;
 };
\ No newline at end of file
@@ -34,6 +34,14 @@ void Explosion::update(float deltaTime)
 	GameObject::update(deltaTime);
 }
 
+void Explosion::onAcquire()
+{
+	// Restart the animation; spawn(position) relies on the default scale
+	m_currentTime = 0.0f;
+	m_sprite->setCurrentFrame(0);
+	getTransform()->setScale(1.0f, 1.0f);
+}
+
 void Explosion::spawn(const Vector2D& position, Vector2D scale)
 {
 	getTransform()->setPosition(position.x, position.y);
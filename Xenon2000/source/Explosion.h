@@ -13,6 +13,7 @@ private:
 public:
 	Explosion();
 	virtual void update(float deltaTime) override;
+	virtual void onAcquire() override;
 
 	void spawn(const Vector2D& position, Vector2D scale);
 	void spawn(const Vector2D& position, float scale);
@@ -24,7 +24,7 @@ void LifeDisplay::init()
 		{
 			auto icon = level->createGameObject<LifeIcon>();
 			icon->getTransform()->setScale(DEFAULT_UI_SCALE);
-			m_lifeIcons.push_back(icon);
+			m_lifeIcons.push_back(icon->getHandle());
 		}
 	}
 
@@ -39,7 +39,7 @@ void LifeDisplay::update(float deltaTime)
 	auto displayPos = getTransform()->getPosition();
 	for (int i = 0; i < m_lifeIcons.size(); ++i)
 	{
-		if (auto icon = m_lifeIcons[i])
+		if (auto icon = getLevel()->resolve<LifeIcon>(m_lifeIcons[i]))
 		{
 			float xOffset = i * (ICON_SPACING * DEFAULT_UI_SCALE);
 			icon->getTransform()->setPosition(
@@ -55,7 +55,7 @@ void LifeDisplay::setLifeCount(int count)
 	count = std::min(std::max(count, 0), MAX_LIVES);
 	for (int i = 0; i < m_lifeIcons.size(); ++i)
 	{
-		if (auto icon = m_lifeIcons[i])
+		if (auto icon = getLevel()->resolve<LifeIcon>(m_lifeIcons[i]))
 		{
 			icon->setVisible(i < count);
 		}
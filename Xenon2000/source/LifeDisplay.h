@@ -7,10 +7,10 @@
 
 class LifeDisplay : public UIElement {
 private:
-	static const int MAX_LIVES = 3;
+	static constexpr int MAX_LIVES = 3;
 	static const float ICON_SPACING;
 	static const float DEFAULT_UI_SCALE;
-	std::vector<LifeIcon*> m_lifeIcons;
+	std::vector<GameObjectHandle> m_lifeIcons;
 
 public:
 	LifeDisplay();
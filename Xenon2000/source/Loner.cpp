@@ -90,7 +90,7 @@ void Loner::shoot()
 	Level* myLevel = getLevel();
 	if (!myLevel) return;
 
-	auto projectile = myLevel->createGameObject<LonerProjectile>();
+	auto projectile = myLevel->acquireGameObject<LonerProjectile>();
 	auto pos = getTransform()->getPosition();
 
 	float projectileX = pos.x + (m_sprite->getFrameWidth() * 0.5f);
@@ -163,14 +163,15 @@ void Loner::takeDamage(float amount)
 		// Create explosion before destroying
 		Vector2D explosionPos = getTransform()->getPosition();
 		if (auto level = getLevel()) {
-			auto explosion = level->createGameObject<Explosion>();
+			auto explosion = level->acquireGameObject<Explosion>();
 			explosion->spawn(explosionPos);
 		}
 
 		// Handle death
 		if (auto xenonLevel = dynamic_cast<XenonLevel*>(m_level))
 		{
-			auto scorePopup = xenonLevel->createGameObject<TextDisplay>(false, true, 1.0f);
+			auto scorePopup = xenonLevel->acquireGameObject<TextDisplay>();
+			scorePopup->setTemporary(1.0f);
 			scorePopup->setPosition(getTransform()->getPosition());
 			scorePopup->setText(std::to_string(m_scoreValue));
 			xenonLevel->addScore(m_scoreValue);
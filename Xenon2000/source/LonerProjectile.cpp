@@ -46,7 +46,7 @@ void LonerProjectile::onSensorBegin(GameObject* other)
 
 	if (damageable && otherPhysics->getLayer() != "Enemy" && otherPhysics->getLayer() != "EnemyProjectile")
 	{
-		auto explosion = getLevel()->createGameObject<ExplosionProjectile>();
+		auto explosion = getLevel()->acquireGameObject<ExplosionProjectile>();
 		explosion->spawn(getTransform()->getPosition());
 
 		//E2_LOG(Warning, "Loner Projectile Applying Damage");
@@ -61,7 +61,7 @@ void LonerProjectile::takeDamage(float amount)
 	// Create explosion before destroying
 	Vector2D explosionPos = getTransform()->getPosition();
 	if (auto level = getLevel()) {
-		auto explosion = level->createGameObject<Explosion>();
+		auto explosion = level->acquireGameObject<Explosion>();
 		explosion->spawn(explosionPos, 0.3f);
 	}
 
@@ -125,11 +125,13 @@ void Player::update(float deltaTime)
 		shoot();
 
 		// Make companions shoot too
-		if (m_companions.left && m_companions.left->isAlive()) {
-			m_companions.left->shoot();
+		auto leftCompanion = getLevel()->resolve<Companion>(m_companions.left);
+		if (leftCompanion && leftCompanion->isAlive()) {
+			leftCompanion->shoot();
 		}
-		if (m_companions.right && m_companions.right->isAlive()) {
-			m_companions.right->shoot();
+		auto rightCompanion = getLevel()->resolve<Companion>(m_companions.right);
+		if (rightCompanion && rightCompanion->isAlive()) {
+			rightCompanion->shoot();
 		}
 	}
 
@@ -184,7 +186,8 @@ void Player::shoot()
 	Level* myLevel = getLevel();
 	if (!myLevel) return;
 
-	auto projectile = myLevel->createGameObject<PlayerProjectile>(m_currentProjectileType);
+	auto projectile = myLevel->acquireGameObject<PlayerProjectile>();
+	projectile->setProjectileType(m_currentProjectileType);
 	auto pos = getTransform()->getPosition();
 
 	float projectileX = pos.x + (m_sprite->getFrameWidth() * 0.4f);
@@ -329,44 +332,45 @@ void Player::onCompanionDeath(bool isLeftSide)
 {
 	if (isLeftSide)
 	{
-		m_companions.left = nullptr;
+		m_companions.left.reset();
 	}
 	else
 	{
-		m_companions.right = nullptr;
+		m_companions.right.reset();
 	}
 }
 
 void Player::addCompanion()
 {
-	if (!m_companions.right)
+	if (!getLevel()->isAlive(m_companions.right))
 	{
 		auto companion = getLevel()->createGameObject<Companion>(Level::PLAYER, this, false, m_projectileSpeed);
 		companion->setEventHandler(this);
-		m_companions.right = companion;
+		m_companions.right = companion->getHandle();
 		return;
 	}
-	else if (!m_companions.left)
+	else if (!getLevel()->isAlive(m_companions.left))
 	{
 		auto companion = getLevel()->createGameObject<Companion>(Level::PLAYER, this, true, m_projectileSpeed);
 		companion->setEventHandler(this);
-		m_companions.left = companion;
+		m_companions.left = companion->getHandle();
 		return;
 	}
 }
 
 void Player::removeCompanions()
 {
-	if (m_companions.right)
+	if (auto companion = getLevel()->resolve(m_companions.right))
 	{
-		getLevel()->removeGameObject(m_companions.right);
-		m_companions.right = nullptr;
+		getLevel()->removeGameObject(companion);
 	}
-	if (m_companions.left)
+	m_companions.right.reset();
+
+	if (auto companion = getLevel()->resolve(m_companions.left))
 	{
-		getLevel()->removeGameObject(m_companions.left);
-		m_companions.left = nullptr;
+		getLevel()->removeGameObject(companion);
 	}
+	m_companions.left.reset();
 }
 
 void Player::upgradeWeapon()
@@ -8,10 +8,10 @@
 #include "LifeDisplay.h"
 #include "HealthBar.h"
 
-// Structure to hold companion pointers
+// Structure to hold companion handles
 struct CompanionPair {
-	Companion* left = nullptr;
-	Companion* right = nullptr;
+	GameObjectHandle left;
+	GameObjectHandle right;
 };
 
 class Player : public Pawn, public IDamageable, public CompanionEventHandler
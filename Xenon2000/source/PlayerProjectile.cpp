@@ -12,7 +12,8 @@ PlayerProjectile::PlayerProjectile(ProjectileType type)
 	: m_damage(25.0f)
 	, m_type(type)
 {
-	// Initialize the current projectile type
+	// Every type shares one sheet; loaded once so pooled projectiles can switch type cheaply
+	setSprite("graphics/missile.bmp", 2, 3);
 	updateProjectileType();
 }
 
@@ -42,14 +43,14 @@ void PlayerProjectile::onSensorBegin(GameObject* other)
 	{
 		//E2_LOG(Warning, "Player Projectile Applying Damage");
 		damageable->takeDamage(m_damage);
-		auto explosion = getLevel()->createGameObject<ExplosionProjectile>();
+		auto explosion = getLevel()->acquireGameObject<ExplosionProjectile>();
 		explosion->spawn(getTransform()->getPosition());
 		deactivate();
 		getLevel()->removeGameObject(this);
 	}
 	if (otherPhysics->getLayer() == "MetalAsteroid")
 	{
-		auto explosion = getLevel()->createGameObject<ExplosionProjectile>();
+		auto explosion = getLevel()->acquireGameObject<ExplosionProjectile>();
 		explosion->spawn(getTransform()->getPosition());
 		deactivate();
 		getLevel()->removeGameObject(this);
@@ -64,7 +65,7 @@ void PlayerProjectile::setProjectileType(ProjectileType type)
 
 void PlayerProjectile::updateProjectileType()
 {
-	auto mySprite = setSprite("graphics/missile.bmp", 2, 3);
+	auto mySprite = getSprite();
 	switch(m_type)
 	{
 	case ProjectileType::Light:
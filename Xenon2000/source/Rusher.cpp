@@ -128,14 +128,15 @@ void Rusher::takeDamage(float amount)
 		// Create explosion before destroying
 		Vector2D explosionPos = getTransform()->getPosition();
 		if (auto level = getLevel()) {
-			auto explosion = level->createGameObject<Explosion>();
+			auto explosion = level->acquireGameObject<Explosion>();
 			explosion->spawn(explosionPos, 0.8f);
 		}
 
 		// Handle death
 		if (auto xenonLevel = dynamic_cast<XenonLevel*>(m_level))
 		{
-			auto scorePopup = xenonLevel->createGameObject<TextDisplay>(false, true, 1.0f);
+			auto scorePopup = xenonLevel->acquireGameObject<TextDisplay>();
+			scorePopup->setTemporary(1.0f);
 			scorePopup->setPosition(getTransform()->getPosition());
 			scorePopup->setText(std::to_string(m_scoreValue));
 			xenonLevel->addScore(m_scoreValue);
@@ -0,0 +1,23 @@
+#include "TextCharacter.h"
+
+TextCharacter::TextCharacter()
+	: m_loadedFont(-1)
+{
+	m_sprite = addComponent<SpriteComponent>();
+}
+
+void TextCharacter::setGlyph(bool useLargeFont, int frame)
+{
+	int font = useLargeFont ? 1 : 0;
+	if (font != m_loadedFont) {
+		if (useLargeFont) {
+			m_sprite->setAnimatedTexture("graphics/font16x16.bmp", 8, 12);
+		}
+		else {
+			m_sprite->setAnimatedTexture("graphics/font8x8.bmp", 8, 16);
+		}
+		m_sprite->setAnimationMode(SpriteComponent::CONTROLLED);
+		m_loadedFont = font;
+	}
+	m_sprite->setCurrentFrame(frame);
+}
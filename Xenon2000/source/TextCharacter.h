@@ -0,0 +1,16 @@
+#pragma once
+
+#include "Engine2000/GameObject.h"
+#include "Engine2000/SpriteComponent.h"
+
+// One glyph of a TextDisplay; pooled, so the font sheet is only loaded when it changes
+class TextCharacter : public GameObject
+{
+private:
+	SpriteComponent* m_sprite;
+	int m_loadedFont;	// -1 none, 0 small, 1 large
+
+public:
+	TextCharacter();
+	void setGlyph(bool useLargeFont, int frame);
+};
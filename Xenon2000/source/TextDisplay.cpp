@@ -1,4 +1,5 @@
 #include "TextDisplay.h"
+#include "TextCharacter.h"
 #include "Engine2000/Level.h"
 
 TextDisplay::TextDisplay(bool useLargeFont, bool isTemporary, float displayTime)
@@ -31,6 +32,28 @@ void TextDisplay::update(float deltaTime)
 	UIElement::update(deltaTime);
 }
 
+void TextDisplay::onAcquire()
+{
+	// Constructor defaults; popups call setTemporary after acquiring
+	m_isLargeFont = false;
+	m_isTemporary = false;
+	m_displayTime = 2.0f;
+	m_currentTime = 0.0f;
+}
+
+void TextDisplay::onRelease()
+{
+	clearCharacters();
+	m_text.clear();
+}
+
+void TextDisplay::setTemporary(float displayTime)
+{
+	m_isTemporary = true;
+	m_displayTime = displayTime;
+	m_currentTime = 0.0f;
+}
+
 void TextDisplay::setText(const std::string& text)
 {
 	if (m_text == text) return;
@@ -42,8 +65,8 @@ void TextDisplay::setText(const std::string& text)
 void TextDisplay::clearCharacters()
 {
 	for (auto& charSprite : m_characters) {
-		if (charSprite.gameObject) {
-			getLevel()->removeGameObject(charSprite.gameObject);
+		if (auto charObj = getLevel()->resolve(charSprite.gameObject)) {
+			getLevel()->removeGameObject(charObj);
 		}
 	}
 	m_characters.clear();
@@ -63,27 +86,16 @@ void TextDisplay::createCharacters()
 	auto basePos = getTransform()->getPosition();
 
 	for (char c : m_text) {
-		// Create game object for this character
-		auto charObj = getLevel()->createGameObject<GameObject>(Level::UI);
-
-		// Add and setup sprite component
-		auto sprite = charObj->addComponent<SpriteComponent>();
-		if (m_isLargeFont) {
-			sprite->setAnimatedTexture("graphics/font16x16.bmp", 8, 12);
-		}
-		else {
-			sprite->setAnimatedTexture("graphics/font8x8.bmp", 8, 16);
-		}
-		sprite->setAnimationMode(SpriteComponent::CONTROLLED);
-		sprite->setCurrentFrame(getCharacterFrame(c));
+		// Characters come from the level's pool and go back to it in clearCharacters
+		auto charObj = getLevel()->acquireGameObject<TextCharacter>(Level::UI);
+		charObj->setGlyph(m_isLargeFont, getCharacterFrame(c));
 
 		// Position the character
 		charObj->getTransform()->setPosition(basePos.x + xOffset, basePos.y);
 
 		// Store character info
 		CharacterSprite charSprite;
-		charSprite.gameObject = charObj;
-		charSprite.sprite = sprite;
+		charSprite.gameObject = charObj->getHandle();
 		charSprite.xOffset = xOffset;
 		m_characters.push_back(charSprite);
 
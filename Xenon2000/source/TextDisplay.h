@@ -9,8 +9,7 @@
 class TextDisplay : public UIElement {
 private:
 	struct CharacterSprite {
-		GameObject* gameObject;
-		SpriteComponent* sprite;
+		GameObjectHandle gameObject;
 		float xOffset;
 	};
 
@@ -29,6 +28,11 @@ public:
 	TextDisplay(bool useLargeFont = false, bool isTemporary = false, float displayTime = 2.0f);
 	virtual void init() override;
 	virtual void update(float deltaTime) override;
+	virtual void onAcquire() override;
+	virtual void onRelease() override;
+
+	// Removes itself after displayTime; used by pooled score popups
+	void setTemporary(float displayTime);
 
 	void setText(const std::string& text);
 	const std::string& getText() const { return m_text; }
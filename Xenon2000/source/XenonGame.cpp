@@ -10,7 +10,7 @@ XenonGame::XenonGame()
 
 void XenonGame::onInit()
 {
-	setCurrentLevel(new XenonLevel(getInput(), getWindowWidth(), getWindowHeight()));
+	setCurrentLevel(new XenonLevel(getInput(), getWindowWidth(), getWindowHeight(), getPhysicsBackend()));
 }
 
 GameEngine* CreateApplication()
@@ -4,6 +4,7 @@
 #include "Engine2000/E2Log.h"
 #include "Engine2000/PhysicsLayerManager.h"
 #include "Engine2000/PhysicsComponent.h"
+#include "Engine2000/TextureAtlas.h"
 
 #include "Player.h"
 #include "Loner.h"
@@ -13,15 +14,20 @@
 #include "ShieldPowerUp.h"
 #include "CompanionPowerUp.h"
 
+#include <algorithm>
 #include <iostream>
 
 
-XenonLevel::XenonLevel(const Input& input, int screenWidth, int screenHeight)
-	: Level(input, screenWidth, screenHeight)
+XenonLevel::XenonLevel(const Input& input, int screenWidth, int screenHeight, PhysicsBackend physicsBackend)
+	: Level(input, screenWidth, screenHeight, physicsBackend)
 	, m_score(0.0f)
 	, m_displayPlayer(nullptr)
 	, m_displayScore(nullptr)
 {
+	// Pack every sprite sheet before anything loads a texture
+	TextureAtlas::Instance().registerDirectory("graphics");
+	TextureAtlas::Instance().build();
+
 	setupScoreDisplay();
 	setupCollisions();
 	setupBackground();
@@ -42,6 +48,13 @@ XenonLevel::~XenonLevel()
 void XenonLevel::update(float deltaTime)
 {
 	Level::update(deltaTime);
+
+	// Drop handles to enemies that have been destroyed
+	m_enemies.erase(
+		std::remove_if(m_enemies.begin(), m_enemies.end(),
+			[this](GameObjectHandle handle) { return !isAlive(handle); }),
+		m_enemies.end());
+
 	m_waveManager->update(deltaTime);
 }
 
@@ -150,14 +163,14 @@ void XenonLevel::createLoner(float y, bool fromRight)
 {
 	auto loner = createGameObject<Loner>(m_screenWidth);
 	loner->spawn(fromRight ? Loner::SpawnSide::RIGHT : Loner::SpawnSide::LEFT, y);
-	m_enemies.push_back(loner);
+	m_enemies.push_back(loner->getHandle());
 }
 
 void XenonLevel::createRusher(float x, bool fromTop)
 {
 	auto rusher = createGameObject<Rusher>(m_screenHeight);
 	rusher->spawn(fromTop ? Rusher::SpawnSide::TOP : Rusher::SpawnSide::BOTTOM, x);
-	m_enemies.push_back(rusher);
+	m_enemies.push_back(rusher->getHandle());
 }
 
 void XenonLevel::createAsteroid(float x, float y, Asteroid::Size size)
@@ -180,7 +193,7 @@ void XenonLevel::createAsteroid(float x, float y, Asteroid::Size size)
 		physics->setVelocity(Vector2D(0.0f, 0.3f));
 	}
 
-	m_enemies.push_back(asteroid);
+	m_enemies.push_back(asteroid->getHandle());
 	//E2_LOG(Log, "Created asteroid at position (%f, %f)", x, y);
 }
 
@@ -199,8 +212,22 @@ void XenonLevel::createMetalAsteroid(float x, float y, MetalAsteroid::Size size)
 void XenonLevel::createDrone(float x, float y, int phase)
 {
 	auto drone = createGameObject<Drone>();
-	drone->spawn(x, y, phase);
-	m_enemies.push_back(drone);
+
+	// Later drones in a group start far above the screen; they wait at the entry line,
+	// dormant, for as long as the descent there would have taken
+	const float entryY = -64.0f;
+	if (y < entryY)
+	{
+		drone->spawn(x, entryY, phase);
+		DormancyTrigger trigger;
+		trigger.wakeAfter = (entryY - y) / drone->getDescendSpeed();
+		makeDormant(drone, trigger);
+	}
+	else
+	{
+		drone->spawn(x, y, phase);
+	}
+	m_enemies.push_back(drone->getHandle());
 	//E2_LOG(Warning, "Created drone at x position %f", x);
 }
 
@@ -239,6 +266,16 @@ void XenonLevel::createRock(float x, float y, Rock::RockType type, bool flipped)
 		physics->setVelocity(Vector2D(0.0f, 0.15f));  // Slow downward movement
 	}
 
+	// Rocks queued above the screen drift down without a body until they reach it
+	if (y < -64.0f)
+	{
+		DormancyTrigger trigger;
+		trigger.drift = true;
+		trigger.useRegion = true;
+		trigger.region = Vector4D(-1.0e6f, -64.0f, 2.0e6f, getScreenHeight() + 64.0f);
+		makeDormant(rock, trigger);
+	}
+
 // 	E2_LOG(Log, "Created rock at position (%f, %f), type: %s, flipped: %d",
 // 		x, y,
 // 		type == Rock::RockType::NARROW ? "NARROW" : "WIDE",
@@ -13,7 +13,7 @@ class XenonLevel : public Level
 {
 private:
 	Player* m_player;
-	std::vector<GameObject*> m_enemies;
+	std::vector<GameObjectHandle> m_enemies;	// Pruned every update
 	XenonWaveManager* m_waveManager;
 
 	TextDisplay* m_displayPlayer;
@@ -21,14 +21,14 @@ private:
 	int m_score;
 
 public:
-	XenonLevel(const Input& input, int screenWidth, int screenHeight);
+	XenonLevel(const Input& input, int screenWidth, int screenHeight, PhysicsBackend physicsBackend = PhysicsBackend::Box2D);
 	~XenonLevel();
 
 	virtual void update(float deltaTime) override;
 
 
 	XenonWaveManager* getWaveManager() { return m_waveManager; }
-	std::vector<GameObject*>& getEnemies() { return m_enemies; }
+	const std::vector<GameObjectHandle>& getEnemies() const { return m_enemies; }
 
 	// GameObject creation methods
 	void createLoner(float y, bool fromRight);